@@ -57,13 +57,14 @@ namespace Heart
         // TODO: safety for when asset object goes out of scope
 
         // Only one load task should ever get created at a time
-        m_LoadingTask = TaskManager::Schedule([this]()
+        u32 generation = m_LoadGeneration;
+        m_LoadingTask = TaskManager::Schedule([this, generation]()
         {
             if (!AssetManager::IsInitialized()) return;
 
             std::lock_guard lock(m_LoadLock);
 
-            if (m_Loaded) return;
+            if (m_Loaded || generation != m_LoadGeneration) return;
 
             LoadInternal();
             UpdateLoadStatus();
@@ -79,6 +80,16 @@ namespace Heart
     {
         std::lock_guard lock(m_LoadLock);
 
+        // A load that has not started yet is no longer wanted. One that has already started
+        // may still be waiting on the lock, so it is told to back off through the generation
+        // rather than loading the asset again right after we unload it
+        m_LoadGeneration++;
+        if (m_LoadingTask.IsValid())
+        {
+            m_LoadingTask.Cancel();
+            m_LoadingTask = Task();
+        }
+
         if (!m_Loaded) return;
 
         UnloadInternal();
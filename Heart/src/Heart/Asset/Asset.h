@@ -116,6 +116,8 @@ namespace Heart
         std::recursive_mutex m_LoadLock;
         std::atomic<u64> m_LoadedFrame = 0;
         Task m_LoadingTask;
+        // Bumped by Unload so that a load task which was already claimed backs off
+        u32 m_LoadGeneration = 0;
 
         friend class AssetManager;
     };
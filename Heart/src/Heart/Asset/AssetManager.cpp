@@ -5,11 +5,22 @@
 #include "Heart/Core/Timing.h"
 #include "Heart/Util/FilesystemUtils.h"
 #include "Heart/Task/TaskManager.h"
+#include "Heart/Container/HMpscQueue.hpp"
 #include "efsw/efsw.hpp"
 
 namespace Heart
 {
 #ifndef HE_PLATFORM_ANDROID
+    struct FileEvent
+    {
+        efsw::Action Action;
+        HString8 Path;
+        HString8 OldPath;
+    };
+
+    // Written from the watcher thread and drained on the main thread by ProcessFileEvents
+    static HMpscQueue<FileEvent> s_FileEvents;
+
     class UpdateListener : public efsw::FileWatchListener
     {
     public:
@@ -32,38 +43,16 @@ namespace Heart
             // Ignore actions in build directories
             if (newPathStr.StartsWith("obj") || newPathStr.StartsWith("bin"))
                 return;
-            
-            switch (action)
+
+            HString8 oldPathStr;
+            if (action == efsw::Actions::Moved)
             {
-                case efsw::Actions::Add:
-                {
-                    Asset::Type assetType = AssetManager::DeduceAssetTypeFromFile(newPathStr);
-                    if (assetType == Asset::Type::None) break;
-                    HE_ENGINE_LOG_DEBUG("Detected new asset '{}', registering", newPathStr.Data());
-                    AssetManager::RegisterAsset(assetType, newPathStr);
-                } break;
-                case efsw::Actions::Delete:
-                {
-                    UUID id = AssetManager::GetAssetUUID(newPathStr);
-                    if (!id) break;
-                    HE_ENGINE_LOG_DEBUG("Detected deletion '{}', unregistering", newPathStr.Data());
-                    AssetManager::UnregisterAsset(id);
-                } break;
-                case efsw::Actions::Modified:
-                {
-                    // TODO: reloading
-                } break;
-                case efsw::Actions::Moved:
-                {
-                    auto oldPath = std::filesystem::path(dir).append(oldFilename);
-                    HString8 oldPathStr = oldPath.u8string();
-                    oldPathStr = AssetManager::GetRelativePath(oldPathStr);
-                    HE_ENGINE_LOG_DEBUG("Detected rename '{}' -> '{}'", oldPathStr.Data(), newPathStr.Data());
-                    AssetManager::RenameAsset(oldPathStr, newPathStr);
-                } break;
-                default:
-                    break;
+                auto oldPath = std::filesystem::path(dir).append(oldFilename);
+                oldPathStr = oldPath.u8string();
+                oldPathStr = AssetManager::GetRelativePath(oldPathStr);
             }
+
+            s_FileEvents.Push({ action, newPathStr, oldPathStr });
         }
     };
 
@@ -149,14 +138,14 @@ namespace Heart
                     {
                         auto lock = std::shared_lock(s_Mutex);
 
-                        auto found = s_UUIDs.find(uuid);
-                        if (found == s_UUIDs.end()) return;
+                        auto found = s_UUIDs.Find(uuid);
+                        if (!found) return;
 
-                        auto& entry = GetRegistry(found->second.IsResource)[found->second.Path];
+                        auto& entry = GetRegistry(found->IsResource)[found->Path];
 
                         HE_ENGINE_LOG_TRACE(
                             "Unloading {0} @ {1}",
-                            found->second.IsResource ? "resource" : "asset", 
+                            found->IsResource ? "resource" : "asset", 
                             entry.Asset->GetPath().Data()
                         );
                     
@@ -192,6 +181,46 @@ namespace Heart
         #ifndef HE_PLATFORM_ANDROID
             s_FileWatcher.reset();
             s_UpdateListener.reset();
+            s_FileEvents.Drain([](const FileEvent&) {});
+        #endif
+    }
+
+    void AssetManager::ProcessFileEvents()
+    {
+        #ifndef HE_PLATFORM_ANDROID
+            HE_PROFILE_FUNCTION();
+
+            s_FileEvents.Drain([](const FileEvent& event)
+            {
+                switch (event.Action)
+                {
+                    case efsw::Actions::Add:
+                    {
+                        Asset::Type assetType = DeduceAssetTypeFromFile(event.Path);
+                        if (assetType == Asset::Type::None) break;
+                        HE_ENGINE_LOG_DEBUG("Detected new asset '{}', registering", event.Path.Data());
+                        RegisterAsset(assetType, event.Path);
+                    } break;
+                    case efsw::Actions::Delete:
+                    {
+                        UUID id = GetAssetUUID(event.Path);
+                        if (!id) break;
+                        HE_ENGINE_LOG_DEBUG("Detected deletion '{}', unregistering", event.Path.Data());
+                        UnregisterAsset(id);
+                    } break;
+                    case efsw::Actions::Modified:
+                    {
+                        // TODO: reloading
+                    } break;
+                    case efsw::Actions::Moved:
+                    {
+                        HE_ENGINE_LOG_DEBUG("Detected rename '{}' -> '{}'", event.OldPath.Data(), event.Path.Data());
+                        RenameAsset(event.OldPath, event.Path);
+                    } break;
+                    default:
+                        break;
+                }
+            });
         #endif
     }
 
@@ -232,12 +261,13 @@ namespace Heart
             isResource ? "resource" : "asset",
             path.Data()
         );
-        GetRegistry(isResource)[path] = {
+        HStringId pathId = path;
+        GetRegistry(isResource)[pathId] = {
             Asset::Create(type, path, absolutePath),
             persistent,
             newUUID
         };
-        s_UUIDs[newUUID] = { path, isResource, type };
+        s_UUIDs[newUUID] = { pathId, isResource, type };
 
         return newUUID;    
     }
@@ -245,10 +275,10 @@ namespace Heart
     void AssetManager::UnregisterAsset(UUID uuid)
     {
         auto lock = std::unique_lock(s_Mutex);
-        auto found = s_UUIDs.find(uuid);
-        if (found == s_UUIDs.end()) return;
-        GetRegistry(found->second.IsResource).erase(found->second.Path);
-        s_UUIDs.erase(uuid);
+        auto found = s_UUIDs.Find(uuid);
+        if (!found) return;
+        GetRegistry(found->IsResource).erase(found->Path);
+        s_UUIDs.Remove(uuid);
     }
 
     UUID AssetManager::RegisterInMemoryAsset(Asset::Type type)
@@ -259,7 +289,7 @@ namespace Heart
 
         // UUID as a string should be sufficient for a unique
         // place in the registry
-        HString8 idPath = std::to_string(newUUID);
+        HStringId idPath = HString8(std::to_string(newUUID));
 
         // Mark the asset's data as loaded & valid so that it never tries
         // to reload it (and fail)
@@ -324,21 +354,22 @@ namespace Heart
     {
         auto lock = std::unique_lock(s_Mutex);
 
-        auto found = s_Registry.find(oldPath);
+        auto found = s_Registry.find(HStringId::Find(oldPath));
         if (found == s_Registry.end()) return;
 
         // Update UUID link
         auto& uuidEntry = s_UUIDs[found->second.Id];
         if (uuidEntry.IsResource) // Cannot update resources
             return;
-        uuidEntry.Path = newPath;
+        HStringId newPathId = newPath;
+        uuidEntry.Path = newPathId;
 
         // Update asset path
         found->second.Asset->UpdatePath(newPath, GetAbsolutePath(newPath));
 
         // Change registry key
-        auto registryNode = s_Registry.extract(oldPath);
-        registryNode.key() = newPath;
+        auto registryNode = s_Registry.extract(found);
+        registryNode.key() = newPathId;
         s_Registry.insert(std::move(registryNode));
     }
 
@@ -362,7 +393,7 @@ namespace Heart
 
         // Remove all registry UUIDs
         for (auto& pair : s_Registry)
-            s_UUIDs.erase(pair.second.Id);
+            s_UUIDs.Remove(pair.second.Id);
 
         // Clear all the registered assets
         s_Registry.clear();
@@ -381,6 +412,10 @@ namespace Heart
             if (s_FileWatcher)
             {
                 s_FileWatcher->removeWatch(s_WatchId);
+
+                // Pending paths are relative to the old directory
+                s_FileEvents.Drain([](const FileEvent&) {});
+
                 WatchAssetDirectory();
             }
         #endif
@@ -422,7 +457,7 @@ namespace Heart
     {
         auto lock = std::shared_lock(s_Mutex);
         auto& registry = GetRegistry(isResource);
-        auto found = registry.find(path);
+        auto found = registry.find(HStringId::Find(path));
         if (found != registry.end())
             return found->second.Id;
         return 0;
@@ -432,18 +467,18 @@ namespace Heart
     {
         if (!uuid) return "";
         auto lock = std::shared_lock(s_Mutex);
-        auto found = s_UUIDs.find(uuid);
-        if (found == s_UUIDs.end()) return "";
-        return found->second.Path;
+        auto found = s_UUIDs.Find(uuid);
+        if (!found) return "";
+        return found->Path.GetString();
     }
 
     bool AssetManager::IsAssetAResource(UUID uuid)
     {
         if (!uuid) return false;
         auto lock = std::shared_lock(s_Mutex);
-        auto found = s_UUIDs.find(uuid);
-        if (found == s_UUIDs.end()) return "";
-        return found->second.IsResource;
+        auto found = s_UUIDs.Find(uuid);
+        if (!found) return false;
+        return found->IsResource;
     }
 
     Asset* AssetManager::RetrieveAsset(const HString8& path, bool isResource)
@@ -453,7 +488,7 @@ namespace Heart
         auto lock = std::shared_lock(s_Mutex);
 
         auto& registry = GetRegistry(isResource);
-        auto found = registry.find(path);
+        auto found = registry.find(HStringId::Find(path));
         if (found == registry.end()) return nullptr;
 
         return found->second.Asset.get();
@@ -467,10 +502,10 @@ namespace Heart
 
         auto lock = std::shared_lock(s_Mutex);
 
-        auto found = s_UUIDs.find(uuid);
-        if (found == s_UUIDs.end()) return nullptr;
+        auto found = s_UUIDs.Find(uuid);
+        if (!found) return nullptr;
 
-        auto& entry = GetRegistry(found->second.IsResource)[found->second.Path];
+        auto& entry = GetRegistry(found->IsResource)[found->Path];
         return entry.Asset.get();
     }
 
@@ -482,7 +517,7 @@ namespace Heart
         for (auto& entry : s_UUIDs)
         {
             auto& elem = j[size++];
-            elem["path"] = entry.second.Path;
+            elem["path"] = entry.second.Path.GetString();
             elem["type"] = entry.second.Type;
             elem["resource"] = entry.second.IsResource;
         }
@@ -4,6 +4,8 @@
 #include "Heart/Task/Task.h"
 #include "Heart/Core/UUID.h"
 #include "Heart/Container/HString8.h"
+#include "Heart/Container/HStringId.h"
+#include "Heart/Container/HFlatMap.hpp"
 
 namespace Heart
 {
@@ -32,7 +34,7 @@ namespace Heart
         /*! @brief The internal representation of an asset inside the UUID registry. */
         struct UUIDEntry
         {
-            HString8 Path;
+            HStringId Path;
             bool IsResource;
             Asset::Type Type;
         };
@@ -54,6 +56,9 @@ namespace Heart
 
         static void DisableFileWatcher();
 
+        /*! @brief Apply the file changes picked up by the watcher since the last call. Main thread only. */
+        static void ProcessFileEvents();
+
         static Task UnloadOldAssets();
 
         inline static bool IsInitialized() { return s_Initialized; }
@@ -66,7 +71,7 @@ namespace Heart
         inline static const HString8& GetDotDirectory() { return s_DotDir; }
 
         /*! @brief Get a reference to the internal asset UUID registry. */
-        inline static const std::unordered_map<UUID, UUIDEntry>& GetUUIDRegistry() { return s_UUIDs; }
+        inline static const HFlatMap<UUID, UUIDEntry>& GetUUIDRegistry() { return s_UUIDs; }
 
         inline static HString8 GetAbsolutePath(const HStringView8& relative)
         { return std::filesystem::path(s_AssetsDirectory.Data()).append(relative.Data()).generic_u8string(); }
@@ -232,9 +237,10 @@ namespace Heart
         inline static const HString8 s_ResourceDirectory = "resources";
         inline static const HString8 s_ManifestFile = "assets.json";
         inline static const HString8 s_DotDir = ".heart";
-        inline static std::unordered_map<UUID, UUIDEntry> s_UUIDs;
-        inline static std::unordered_map<HString8, AssetEntry> s_Registry;
-        inline static std::unordered_map<HString8, AssetEntry> s_Resources;
+        inline static HFlatMap<UUID, UUIDEntry> s_UUIDs;
+        // Keyed by interned paths so that UUID lookups never hash or compare path strings
+        inline static std::unordered_map<HStringId, AssetEntry> s_Registry;
+        inline static std::unordered_map<HStringId, AssetEntry> s_Resources;
         inline static HString8 s_AssetsDirectory;
         inline static Task s_UnloadTask;
 
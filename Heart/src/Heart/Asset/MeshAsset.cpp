@@ -375,7 +375,7 @@ namespace Heart
                 }
             }
 
-            m_Submeshes.AddInPlace(pair.second.Vertices, pair.second.Indices, pair.first);
+            m_Submeshes.AddInPlace(std::move(pair.second.Vertices), std::move(pair.second.Indices), pair.first);
         }
     }
 
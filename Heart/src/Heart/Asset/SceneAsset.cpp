@@ -77,7 +77,7 @@ namespace Heart
                 if (loaded.contains("childrenComponent"))
                 {
                     auto& children = loaded["childrenComponent"]["children"];
-                    HVector<UUID> ids;
+                    HSmallVector<UUID, 4> ids;
                     ids.Reserve(children.size());
                     for (auto& childId : children)
                         ids.AddInPlace(static_cast<UUID>(childId));
@@ -89,7 +89,7 @@ namespace Heart
                 {
                     auto& compEntry = loaded["meshComponent"];
                     auto& materials = compEntry["materials"];
-                    HVector<UUID> materialIds;
+                    HSmallVector<UUID, 4> materialIds;
                     UUID meshAsset = AssetManager::RegisterAsset(Asset::Type::Mesh, compEntry["mesh"]["path"], false, compEntry["mesh"]["engineResource"]);
                     for (auto& material : materials)
                         materialIds.AddInPlace(AssetManager::RegisterAsset(Asset::Type::Material, material["path"], false, material["engineResource"]));
@@ -2,7 +2,61 @@
 
 namespace Heart
 {
-    // Todo: thread-safety
+    // Whether a T can be moved to a new address by copying its bytes, skipping the move constructor
+    // and destructor. Defaults to trivially copyable types and is specialized next to engine types
+    // that only own heap memory. Anything holding a pointer into itself must not be marked
+    template <typename T>
+    struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+    template <typename T>
+    struct IsTriviallyRelocatable<std::shared_ptr<T>> : std::true_type {};
+    template <typename T>
+    struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+    // std::pair is never trivially copyable since it defines its own assignment. Map entries have a
+    // const key, which doesn't change how it can be moved
+    template <typename A, typename B>
+    struct IsTriviallyRelocatable<std::pair<A, B>>
+        : std::bool_constant<
+            IsTriviallyRelocatable<std::remove_const_t<A>>::value &&
+            IsTriviallyRelocatable<std::remove_const_t<B>>::value
+        >
+    {};
+
+    // Types that cannot be moved at all have always been relocated bytewise, so they keep that
+    template <typename T>
+    inline constexpr bool CanRelocateWithMemcpy = IsTriviallyRelocatable<T>::value || !std::is_move_constructible<T>::value;
+
+    // Moves count elements from src into uninitialized memory at dst, leaving src uninitialized.
+    // The ranges may overlap
+    template <typename T>
+    void RelocateElements(T* dst, T* src, u32 count)
+    {
+        if (count == 0 || dst == src) return;
+
+        if constexpr (CanRelocateWithMemcpy<T>)
+            memmove(dst, src, count * sizeof(T));
+        else if (dst < src)
+        {
+            for (u32 i = 0; i < count; i++)
+            {
+                HE_PLACEMENT_NEW(dst + i, T, std::move(src[i]));
+                src[i].~T();
+            }
+        }
+        else
+        {
+            for (u32 i = count; i > 0; i--)
+            {
+                HE_PLACEMENT_NEW(dst + i - 1, T, std::move(src[i - 1]));
+                src[i - 1].~T();
+            }
+        }
+    }
+
+    // Buffers can be shared between containers through an atomic reference count, so shallow copies
+    // may be handed to and released from any thread. Anything that changes the size of a shared
+    // buffer first gives the container its own copy. Writing elements in place does not, so call
+    // MakeUnique before doing that to a buffer that may be shared
     template <typename T>
     class Container
     {
@@ -15,9 +69,9 @@ namespace Heart
         }
 
         Container(Container<T>&& other)
+            : m_Data(other.m_Data)
         {
-            Copy(other, true);
-            other.Cleanup();
+            other.m_Data = nullptr;
         }
 
         Container(u32 elemCount, bool fill = true)
@@ -63,6 +117,7 @@ namespace Heart
 
         void Copy(const Container<T>& other, bool shallow = false)
         {
+            if (&other == this) return;
             Cleanup();
             if (shallow)
             {
@@ -81,9 +136,10 @@ namespace Heart
         {
             if (Count() == 0) return;
 
-            if (shrink)
+            // No point copying a shared buffer just to empty it
+            if (shrink || IsShared())
             {
-                Resize(0);
+                Cleanup();
                 return;
             }
 
@@ -111,6 +167,7 @@ namespace Heart
         void Trim(u32 newCount)
         {
             if (newCount >= Count()) return;
+            MakeUnique();
             
             // Destruct removed elements
             if constexpr (m_ShouldDestruct)
@@ -126,7 +183,8 @@ namespace Heart
         inline u32 Count() const { return m_Data ? CountUnchecked() : 0; }
         inline u32 CountUnchecked() const { return GetInfoPtr()->ElemCount; }
         inline u32 GetAllocatedCount() const { return m_Data ? GetInfoPtr()->AllocatedCount : 0; }
-        inline u32 GetRefCount() const { return m_Data ? GetInfoPtr()->RefCount : 1; } // Default is 1 for this obj
+        inline u32 GetRefCount() const { return m_Data ? GetInfoPtr()->RefCount.load(std::memory_order_relaxed) : 1; } // Default is 1 for this obj
+        inline bool IsShared() const { return GetRefCount() > 1; }
         inline u32 IncrementCount() { return ++GetInfoPtr()->ElemCount; }
         inline u32 DecrementCount() { return --GetInfoPtr()->ElemCount; }
         inline T* Data() const { return m_Data; }
@@ -139,12 +197,46 @@ namespace Heart
         inline T& operator[](u32 index) const { return Get(index); }
         inline void operator=(const Container<T>& other) { Copy(other); }
 
+        // Makes room for one more element at the end and returns its index. The slot is left
+        // uninitialized for the caller to construct into
+        u32 AddUninitialized()
+        {
+            MakeUnique();
+            u32 count = Count();
+            if (count >= GetAllocatedCount())
+                ResizeExplicit(count + 1, count < MinimumAllocCount ? MinimumAllocCount : count * 2, false);
+            else
+                IncrementCount();
+            return count;
+        }
+
+        // Replaces a shared buffer with a copy owned only by this container
+        void MakeUnique()
+        {
+            if (!IsShared()) return;
+
+            Container<T> shared;
+            shared.m_Data = m_Data;
+            m_Data = nullptr;
+            ResizeExplicit(shared.Count(), shared.GetAllocatedCount(), false);
+            if constexpr (m_CanMemcpy)
+                memcpy(m_Data, shared.m_Data, shared.Count() * sizeof(T));
+            else if constexpr (std::is_copy_constructible<T>::value)
+            {
+                for (u32 i = 0; i < shared.Count(); i++)
+                    HE_PLACEMENT_NEW(m_Data + i, T, shared.m_Data[i]);
+            }
+            else
+                HE_ENGINE_ASSERT(false, "Cannot modify a shared container of a type that cannot be copied");
+        }
+
         inline static constexpr u32 MinimumAllocCount = 16;
 
     private:
+        // Mirrored by ContainerInfo in ContainerData.cs
         struct ContainerInfo
         {
-            u32 RefCount;
+            std::atomic<u32> RefCount;
             u32 AllocatedCount;
             u32 ElemCount;
         };
@@ -173,6 +265,8 @@ namespace Heart
                 return;
             }
 
+            MakeUnique();
+
             u32 oldCount = Count();
             if (elemCount < oldCount)
             {
@@ -185,14 +279,13 @@ namespace Heart
             if (allocCount != GetAllocatedCount())
             {
                 ContainerInfo* data = reinterpret_cast<ContainerInfo*>(::operator new(allocCount * sizeof(T) + sizeof(ContainerInfo)));
-                data->RefCount = GetRefCount();
+                HE_PLACEMENT_NEW(&data->RefCount, std::atomic<u32>, 1);
                 data->AllocatedCount = allocCount;
                 T* newData = reinterpret_cast<T*>(data + 1);
         
                 if (m_Data)
                 {
-                    // TODO: check if trivially copyable
-                    memcpy(newData, m_Data, std::min(elemCount, oldCount) * sizeof(T));
+                    RelocateElements(newData, m_Data, std::min(elemCount, oldCount));
                     FreeMemory();
                 }
                 
@@ -213,7 +306,7 @@ namespace Heart
         void FreeMemory()
         {
             // Delete initial (origin) pointer
-            delete[] (reinterpret_cast<ContainerInfo*>(m_Data) - 1);
+            ::operator delete(reinterpret_cast<ContainerInfo*>(m_Data) - 1);
         }
 
         void Cleanup()
@@ -233,8 +326,9 @@ namespace Heart
         }
 
         inline ContainerInfo* GetInfoPtr() const { return reinterpret_cast<ContainerInfo*>(m_Data) - 1; }
-        inline u32 IncrementRefCount() { return ++GetInfoPtr()->RefCount; }
-        inline u32 DecrementRefCount() { return --GetInfoPtr()->RefCount; }
+        inline u32 IncrementRefCount() { return GetInfoPtr()->RefCount.fetch_add(1, std::memory_order_relaxed) + 1; }
+        // Acquire so that the last owner sees every write made before the other owners let go
+        inline u32 DecrementRefCount() { return GetInfoPtr()->RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
         inline void SetCount(u32 count) { GetInfoPtr()->ElemCount = count; }
         inline static constexpr bool m_ShouldDestruct = std::is_destructible<T>::value && !std::is_trivially_destructible<T>::value;
         inline static constexpr bool m_ShouldConstruct = std::is_default_constructible<T>::value;
@@ -243,4 +337,7 @@ namespace Heart
     private:
         T* m_Data = nullptr;
     };
+
+    template <typename T>
+    struct IsTriviallyRelocatable<Container<T>> : std::true_type {};
 }
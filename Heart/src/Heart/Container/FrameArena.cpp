@@ -0,0 +1,117 @@
+#include "hepch.h"
+#include "FrameArena.h"
+
+namespace Heart
+{
+    void FrameArena::Initialize(u32 frameCount, size_t capacity)
+    {
+        if (s_Initialized) return;
+
+        frameCount = std::max(frameCount, 2u);
+        for (u32 i = 0; i < frameCount; i++)
+        {
+            s_Arenas.AddInPlace(CreateScope<Arena>());
+            auto& arena = *s_Arenas.Back();
+            arena.Capacity = capacity;
+            arena.Memory = static_cast<u8*>(::operator new(capacity));
+        }
+
+        s_FrameNumber.store(0, std::memory_order_release);
+        s_Initialized = true;
+    }
+
+    void FrameArena::Shutdown()
+    {
+        if (!s_Initialized) return;
+
+        for (auto& arena : s_Arenas)
+            FreeArena(*arena);
+        s_Arenas.Clear(true);
+
+        s_Initialized = false;
+    }
+
+    void FrameArena::BeginFrame()
+    {
+        HE_PROFILE_FUNCTION();
+        HE_ENGINE_ASSERT(s_Initialized, "FrameArena must be initialized before beginning a frame");
+
+        // Nothing from the frame that last used this arena can still be alive, so reset it before
+        // handing it out
+        u64 nextFrame = s_FrameNumber.load(std::memory_order_relaxed) + 1;
+        ResetArena(*s_Arenas[nextFrame % s_Arenas.Count()]);
+        s_FrameNumber.store(nextFrame, std::memory_order_release);
+    }
+
+    void* FrameArena::Allocate(size_t size, size_t alignment)
+    {
+        HE_ENGINE_ASSERT(s_Initialized, "FrameArena must be initialized before allocating");
+        HE_ENGINE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+        // Over-reserve so that the result can be aligned without a compare and swap loop
+        Arena& arena = GetCurrentArena();
+        size_t reserved = size + alignment - 1;
+        size_t offset = arena.Offset.fetch_add(reserved, std::memory_order_relaxed);
+        if (offset + reserved <= arena.Capacity)
+        {
+            uintptr_t address = reinterpret_cast<uintptr_t>(arena.Memory + offset);
+            return reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+        }
+
+        // Out of space for this frame. The offset keeps counting so that the arena can be resized
+        // to fit everything once it is reset
+        void* block = ::operator new(reserved);
+        std::lock_guard lock(arena.OverflowLock);
+        arena.OverflowBlocks.Add(block);
+        uintptr_t address = reinterpret_cast<uintptr_t>(block);
+        return reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+    }
+
+    size_t FrameArena::GetBytesUsed()
+    {
+        if (!s_Initialized) return 0;
+        return GetCurrentArena().Offset.load(std::memory_order_relaxed);
+    }
+
+    u32 FrameArena::GetOverflowCount()
+    {
+        if (!s_Initialized) return 0;
+        Arena& arena = GetCurrentArena();
+        std::lock_guard lock(arena.OverflowLock);
+        return arena.OverflowBlocks.Count();
+    }
+
+    void FrameArena::ResetArena(Arena& arena)
+    {
+        size_t used = arena.Offset.load(std::memory_order_relaxed);
+        if (used > arena.Capacity)
+        {
+            // Grow with some headroom so that frames that fluctuate in size don't keep overflowing
+            size_t newCapacity = arena.Capacity;
+            while (newCapacity < used)
+                newCapacity *= 2;
+
+            ::operator delete(arena.Memory);
+            arena.Memory = static_cast<u8*>(::operator new(newCapacity));
+            arena.Capacity = newCapacity;
+        }
+
+        for (void* block : arena.OverflowBlocks)
+            ::operator delete(block);
+        arena.OverflowBlocks.Clear();
+
+        arena.Offset.store(0, std::memory_order_relaxed);
+    }
+
+    void FrameArena::FreeArena(Arena& arena)
+    {
+        for (void* block : arena.OverflowBlocks)
+            ::operator delete(block);
+        arena.OverflowBlocks.Clear(true);
+
+        ::operator delete(arena.Memory);
+        arena.Memory = nullptr;
+        arena.Capacity = 0;
+        arena.Offset.store(0, std::memory_order_relaxed);
+    }
+}
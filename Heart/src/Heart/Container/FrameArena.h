@@ -0,0 +1,262 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+
+namespace Heart
+{
+    // Linear allocator for data that only lives for a frame or two. There is one arena for every frame
+    // that can be in flight, and beginning a frame resets the oldest one in O(1), so memory handed out
+    // during frame N stays valid until frame N + GetFrameCount() begins. Allocating is a single atomic
+    // add and can happen from any thread. When an arena runs out, allocations fall back to the heap
+    // and the arena grows to fit the next time it is reset, so steady state frames never hit the heap
+    class FrameArena
+    {
+    public:
+        // At least two arenas are always kept so that work spilling over into the next frame stays valid
+        static void Initialize(u32 frameCount, size_t capacity = DefaultCapacity);
+        static void Shutdown();
+
+        // Must be called from the main thread before anything is allocated for the new frame
+        static void BeginFrame();
+
+        static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        inline static T* Allocate(u32 count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+
+        inline static u64 GetFrameNumber() { return s_FrameNumber.load(std::memory_order_acquire); }
+        inline static u32 GetFrameCount() { return s_Arenas.Count(); }
+        inline static bool IsInitialized() { return s_Initialized; }
+
+        // Bytes requested from the current frame's arena so far, including anything that spilled onto the heap
+        static size_t GetBytesUsed();
+
+        // Heap fallbacks since the current frame's arena was reset
+        static u32 GetOverflowCount();
+
+        inline static constexpr size_t DefaultCapacity = Megabytes(1);
+
+    private:
+        struct Arena
+        {
+            u8* Memory = nullptr;
+            size_t Capacity = 0;
+            alignas(64) std::atomic<size_t> Offset = 0;
+
+            std::mutex OverflowLock;
+            HVector<void*> OverflowBlocks;
+        };
+
+    private:
+        static void ResetArena(Arena& arena);
+        static void FreeArena(Arena& arena);
+        inline static Arena& GetCurrentArena() { return *s_Arenas[GetFrameNumber() % s_Arenas.Count()]; }
+
+    private:
+        inline static HVector<Scope<Arena>> s_Arenas;
+        inline static std::atomic<u64> s_FrameNumber = 0;
+        inline static bool s_Initialized = false;
+    };
+
+    // Growable array whose storage comes from the FrameArena. Growing copies into a fresh block and
+    // abandons the old one, so nothing is ever freed. Clearing in a later frame drops the storage,
+    // since it may belong to an arena that has been reset. Only types that can be copied bytewise
+    // are allowed because destructors never run
+    template <typename T>
+    class FrameVector
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "FrameVector elements must be trivially copyable");
+
+    public:
+        FrameVector() = default;
+        FrameVector(const FrameVector&) = delete;
+        FrameVector& operator=(const FrameVector&) = delete;
+
+        FrameVector(FrameVector&& other)
+            : m_Data(other.m_Data), m_Count(other.m_Count), m_AllocatedCount(other.m_AllocatedCount), m_Frame(other.m_Frame)
+        {
+            other.m_Data = nullptr;
+            other.m_Count = 0;
+            other.m_AllocatedCount = 0;
+        }
+
+        T& Add(const T& elem)
+        {
+            // Copy first in case elem lives inside of this vector and the add reallocates
+            T copy = elem;
+            if (m_Count >= m_AllocatedCount)
+                Grow(m_Count + 1);
+            m_Data[m_Count] = copy;
+            return m_Data[m_Count++];
+        }
+
+        template <class... Args>
+        T& AddInPlace(Args&&... args)
+        {
+            if (m_Count >= m_AllocatedCount)
+                Grow(m_Count + 1);
+            return *HE_PLACEMENT_NEW(m_Data + m_Count++, T, std::forward<Args>(args)...);
+        }
+
+        void Pop()
+        {
+            if (m_Count == 0) throw std::out_of_range("Called Pop() on empty container");
+            m_Count--;
+        }
+
+        void Reserve(u32 allocCount)
+        {
+            if (allocCount > m_AllocatedCount)
+                Grow(allocCount);
+        }
+
+        // New elements are value initialized
+        void Resize(u32 elemCount)
+        {
+            Reserve(elemCount);
+            for (u32 i = m_Count; i < elemCount; i++)
+                HE_PLACEMENT_NEW(m_Data + i, T);
+            m_Count = elemCount;
+        }
+
+        void Clear()
+        {
+            m_Count = 0;
+            if (m_Frame != FrameArena::GetFrameNumber())
+            {
+                m_Data = nullptr;
+                m_AllocatedCount = 0;
+            }
+        }
+
+        inline u32 Count() const { return m_Count; }
+        inline u32 GetAllocatedCount() const { return m_AllocatedCount; }
+        inline T* Data() const { return m_Data; }
+        inline T* Begin() const { return m_Data; }
+        inline T* End() const { return m_Data + m_Count; }
+        inline T& Front() const { return Get(0); }
+        inline T& Back() const { return Get(m_Count - 1); }
+        inline bool IsEmpty() const { return m_Count == 0; }
+        inline T& Get(u32 index) const
+        { HE_ENGINE_ASSERT(index < m_Count, "FrameVector access out of bounds"); return m_Data[index]; }
+
+        inline T& operator[](u32 index) const { return Get(index); }
+
+        // For range loops
+        inline T* begin() const { return Begin(); }
+        inline T* end() const { return End(); }
+
+    private:
+        void Grow(u32 minCount)
+        {
+            u32 allocCount = std::max(minCount, std::max(m_AllocatedCount * 2, MinimumAllocCount));
+
+            // Read the frame before allocating so that a frame boundary in between errs towards
+            // dropping the storage early rather than late
+            u64 frame = FrameArena::GetFrameNumber();
+            T* newData = FrameArena::Allocate<T>(allocCount);
+            if (m_Count > 0)
+                memcpy(newData, m_Data, m_Count * sizeof(T));
+
+            m_Data = newData;
+            m_AllocatedCount = allocCount;
+            m_Frame = frame;
+        }
+
+    private:
+        inline static constexpr u32 MinimumAllocCount = 16;
+
+    private:
+        T* m_Data = nullptr;
+        u32 m_Count = 0;
+        u32 m_AllocatedCount = 0;
+        u64 m_Frame = 0;
+    };
+
+    // Open addressing hash map backed by FrameVectors. Entries are stored densely in insertion order,
+    // which is also the iteration order, and pointers to them stay valid until the next insertion.
+    // Removal is not supported; the whole map is cleared at once
+    template <typename K, typename V, typename Hash = std::hash<K>>
+    class FrameHashMap
+    {
+    public:
+        struct Entry
+        {
+            K Key;
+            V Value;
+        };
+
+    public:
+        V& operator[](const K& key)
+        {
+            // Keep the load factor at or below one half
+            if ((m_Entries.Count() + 1) * 2 > m_Slots.Count())
+                Rehash(std::max(m_Slots.Count() * 2, MinimumSlotCount));
+
+            u32 slot = FindSlot(key);
+            if (m_Slots[slot] != EmptySlot)
+                return m_Entries[m_Slots[slot] - 1].Value;
+
+            m_Entries.Add({ key, V() });
+            m_Slots[slot] = m_Entries.Count();
+            return m_Entries.Back().Value;
+        }
+
+        V* Find(const K& key) const
+        {
+            if (m_Entries.IsEmpty()) return nullptr;
+
+            u32 slot = FindSlot(key);
+            if (m_Slots[slot] == EmptySlot) return nullptr;
+            return &m_Entries[m_Slots[slot] - 1].Value;
+        }
+
+        inline bool Contains(const K& key) const { return Find(key) != nullptr; }
+
+        void Clear()
+        {
+            m_Entries.Clear();
+            m_Slots.Clear();
+        }
+
+        inline u32 Count() const { return m_Entries.Count(); }
+        inline bool IsEmpty() const { return m_Entries.IsEmpty(); }
+
+        // For range loops
+        inline Entry* begin() const { return m_Entries.Begin(); }
+        inline Entry* end() const { return m_Entries.End(); }
+
+    private:
+        // Returns either the slot holding key or the empty slot where it belongs
+        u32 FindSlot(const K& key) const
+        {
+            u32 mask = m_Slots.Count() - 1;
+            u32 slot = HashKey(key) & mask;
+            while (m_Slots[slot] != EmptySlot && !(m_Entries[m_Slots[slot] - 1].Key == key))
+                slot = (slot + 1) & mask;
+            return slot;
+        }
+
+        void Rehash(u32 slotCount)
+        {
+            m_Slots.Clear();
+            m_Slots.Resize(slotCount);
+            for (u32 i = 0; i < m_Entries.Count(); i++)
+                m_Slots[FindSlot(m_Entries[i].Key)] = i + 1;
+        }
+
+        // Fibonacci hashing spreads out keys that differ only in their low bits (i.e. pointers)
+        inline static u32 HashKey(const K& key)
+        {
+            return static_cast<u32>((static_cast<u64>(Hash()(key)) * 11400714819323198485ull) >> 32);
+        }
+
+    private:
+        inline static constexpr u32 EmptySlot = 0;
+        inline static constexpr u32 MinimumSlotCount = 16;
+
+    private:
+        FrameVector<Entry> m_Entries;
+        FrameVector<u32> m_Slots; // One plus the index of the entry, or EmptySlot
+    };
+}
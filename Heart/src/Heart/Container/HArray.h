@@ -54,6 +54,9 @@ namespace Heart
         HVector<Variant> m_Data;
     };
 
+    template <>
+    struct IsTriviallyRelocatable<HArray> : std::true_type {};
+
     void to_json(nlohmann::json& j, const HArray& str);
     void from_json(const nlohmann::json& j, HArray& str);
 }
\ No newline at end of file
@@ -0,0 +1,435 @@
+#pragma once
+
+#include "Heart/Container/Container.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define HE_FLAT_TABLE_SSE2
+    #include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace Heart
+{
+    // Open addressing hash table shared by HFlatMap and HFlatSet. Entries live directly in one
+    // contiguous array of buckets alongside an array of control bytes, so a lookup is usually one
+    // control byte read plus one entry read. Each control byte is either empty or the top seven bits
+    // of the hash of the key in that bucket, which lets lookups compare sixteen buckets at once and
+    // only touch the entries whose fingerprint matched. Probing is linear and removing uses backward
+    // shift deletion, so no tombstones ever build up
+    template <typename K, typename E, typename Hash>
+    class HFlatTable
+    {
+    public:
+        class Iterator
+        {
+        public:
+            Iterator(const HFlatTable* table, u32 bucket)
+                : m_Table(table), m_Bucket(bucket)
+            {}
+
+            inline E& operator*() const { return m_Table->m_Entries[m_Bucket]; }
+            inline E* operator->() const { return m_Table->m_Entries + m_Bucket; }
+            inline bool operator==(const Iterator& other) const { return m_Bucket == other.m_Bucket; }
+            inline bool operator!=(const Iterator& other) const { return m_Bucket != other.m_Bucket; }
+
+            inline Iterator& operator++()
+            {
+                m_Bucket = m_Table->FindFullBucket(m_Bucket + 1);
+                return *this;
+            }
+
+        private:
+            const HFlatTable* m_Table;
+            u32 m_Bucket;
+        };
+
+    public:
+        HFlatTable() = default;
+
+        ~HFlatTable()
+        {
+            Clear(true);
+        }
+
+        HFlatTable(const HFlatTable& other)
+        {
+            Copy(other);
+        }
+
+        HFlatTable(HFlatTable&& other)
+        {
+            Take(other);
+        }
+
+        HFlatTable& operator=(const HFlatTable& other)
+        {
+            if (&other != this)
+                Copy(other);
+            return *this;
+        }
+
+        HFlatTable& operator=(HFlatTable&& other)
+        {
+            if (&other != this)
+            {
+                Clear(true);
+                Take(other);
+            }
+            return *this;
+        }
+
+        // Returns a pointer to the entry for key, or nullptr if there isn't one
+        E* FindEntry(const K& key) const
+        {
+            if (m_Count == 0) return nullptr;
+
+            u32 bucket = FindBucket(key, HashKey(key));
+            if (bucket == InvalidBucket) return nullptr;
+            return m_Entries + bucket;
+        }
+
+        inline bool Contains(const K& key) const { return FindEntry(key) != nullptr; }
+
+        bool Remove(const K& key)
+        {
+            if (m_Count == 0) return false;
+
+            u32 hole = FindBucket(key, HashKey(key));
+            if (hole == InvalidBucket) return false;
+
+            if constexpr (m_ShouldDestruct)
+                m_Entries[hole].~E();
+            m_Count--;
+
+            // Pull back every following entry that is not already in its home bucket so that
+            // lookups never have to skip over a gap
+            u32 mask = GetMask();
+            for (u32 next = (hole + 1) & mask; m_Control[next] != EmptyControl; next = (next + 1) & mask)
+            {
+                u32 home = HashKey(GetKey(m_Entries[next])) & mask;
+                if (((next - home) & mask) < ((next - hole) & mask))
+                    continue;
+
+                SetControl(hole, m_Control[next]);
+                RelocateElements(m_Entries + hole, m_Entries + next, 1);
+                hole = next;
+            }
+            SetControl(hole, EmptyControl);
+
+            return true;
+        }
+
+        void Reserve(u32 count)
+        {
+            if (count > GetMaxLoad(m_BucketCount))
+                Rehash(GetBucketCountFor(count));
+        }
+
+        // Shrinking frees the buckets as well
+        void Clear(bool shrink = false)
+        {
+            if constexpr (m_ShouldDestruct)
+            {
+                if (m_Count > 0)
+                    for (u32 i = 0; i < m_BucketCount; i++)
+                        if (m_Control[i] != EmptyControl)
+                            m_Entries[i].~E();
+            }
+            m_Count = 0;
+
+            if (shrink)
+            {
+                ::operator delete(m_Entries);
+                m_Entries = nullptr;
+                m_Control = nullptr;
+                m_BucketCount = 0;
+            }
+            else if (m_BucketCount > 0)
+                memset(m_Control, EmptyControl, m_BucketCount + GroupWidth);
+        }
+
+        inline u32 Count() const { return m_Count; }
+        inline u32 GetBucketCount() const { return m_BucketCount; }
+        inline bool IsEmpty() const { return m_Count == 0; }
+        inline Iterator Begin() const { return Iterator(this, m_Count == 0 ? m_BucketCount : FindFullBucket(0)); }
+        inline Iterator End() const { return Iterator(this, m_BucketCount); }
+
+        // For range loops
+        inline Iterator begin() const { return Begin(); }
+        inline Iterator end() const { return End(); }
+
+    protected:
+        // Returns the entry for key, or an empty bucket reserved for it along with true. In that case
+        // the caller must construct the entry in place before anything else touches the table
+        std::pair<E*, bool> FindOrPrepareInsert(const K& key)
+        {
+            u32 hash = HashKey(key);
+            if (m_Count > 0)
+            {
+                u32 bucket = FindBucket(key, hash);
+                if (bucket != InvalidBucket)
+                    return { m_Entries + bucket, false };
+            }
+
+            if (m_Count + 1 > GetMaxLoad(m_BucketCount))
+                Rehash(GetBucketCountFor(m_Count + 1));
+
+            u32 bucket = FindEmptyBucket(hash);
+            SetControl(bucket, GetFingerprint(hash));
+            m_Count++;
+            return { m_Entries + bucket, true };
+        }
+
+        inline static const K& GetKey(const E& entry)
+        {
+            if constexpr (std::is_same<K, E>::value)
+                return entry;
+            else
+                return entry.first;
+        }
+
+    private:
+        u32 FindBucket(const K& key, u32 hash) const
+        {
+            u32 mask = GetMask();
+            u8 fingerprint = GetFingerprint(hash);
+            for (u32 group = hash & mask; ; group = (group + GroupWidth) & mask)
+            {
+                const u8* control = m_Control + group;
+                for (u32 matches = MatchByte(control, fingerprint); matches != 0; matches &= matches - 1)
+                {
+                    u32 bucket = (group + CountTrailingZeros(matches)) & mask;
+                    if (GetKey(m_Entries[bucket]) == key)
+                        return bucket;
+                }
+
+                // Keys are never placed past an empty bucket in their probe sequence
+                if (MatchEmpty(control) != 0) return InvalidBucket;
+            }
+        }
+
+        u32 FindEmptyBucket(u32 hash) const
+        {
+            u32 mask = GetMask();
+            for (u32 group = hash & mask; ; group = (group + GroupWidth) & mask)
+            {
+                u32 empty = MatchEmpty(m_Control + group);
+                if (empty != 0)
+                    return (group + CountTrailingZeros(empty)) & mask;
+            }
+        }
+
+        // First full bucket at or after start, or the bucket count if there are none
+        u32 FindFullBucket(u32 start) const
+        {
+            for (u32 group = start; group < m_BucketCount; group += GroupWidth)
+            {
+                u32 full = ~MatchEmpty(m_Control + group) & GroupMask;
+                if (full != 0)
+                    return std::min(group + CountTrailingZeros(full), m_BucketCount);
+            }
+            return m_BucketCount;
+        }
+
+        void Rehash(u32 bucketCount)
+        {
+            E* oldEntries = m_Entries;
+            u8* oldControl = m_Control;
+            u32 oldBucketCount = m_BucketCount;
+
+            Allocate(bucketCount);
+            for (u32 i = 0; i < oldBucketCount; i++)
+            {
+                if (oldControl[i] == EmptyControl) continue;
+
+                u32 bucket = FindEmptyBucket(HashKey(GetKey(oldEntries[i])));
+                SetControl(bucket, oldControl[i]);
+                RelocateElements(m_Entries + bucket, oldEntries + i, 1);
+            }
+
+            ::operator delete(oldEntries);
+        }
+
+        // Entries and control bytes share one allocation, with the control bytes at the end since
+        // they have no alignment requirement. The first group of control bytes is mirrored past the
+        // end so that a group can always be loaded starting from any bucket
+        void Allocate(u32 bucketCount)
+        {
+            m_Entries = static_cast<E*>(::operator new(bucketCount * sizeof(E) + bucketCount + GroupWidth));
+            m_Control = reinterpret_cast<u8*>(m_Entries + bucketCount);
+            m_BucketCount = bucketCount;
+            memset(m_Control, EmptyControl, bucketCount + GroupWidth);
+        }
+
+        void Copy(const HFlatTable& other)
+        {
+            Clear(true);
+            if (other.m_Count == 0) return;
+
+            Allocate(other.m_BucketCount);
+            memcpy(m_Control, other.m_Control, m_BucketCount + GroupWidth);
+            if constexpr (m_CanMemcpy)
+                memcpy(m_Entries, other.m_Entries, m_BucketCount * sizeof(E));
+            else
+            {
+                for (u32 i = 0; i < m_BucketCount; i++)
+                    if (m_Control[i] != EmptyControl)
+                        HE_PLACEMENT_NEW(m_Entries + i, E, other.m_Entries[i]);
+            }
+            m_Count = other.m_Count;
+        }
+
+        void Take(HFlatTable& other)
+        {
+            m_Entries = other.m_Entries;
+            m_Control = other.m_Control;
+            m_BucketCount = other.m_BucketCount;
+            m_Count = other.m_Count;
+            other.m_Entries = nullptr;
+            other.m_Control = nullptr;
+            other.m_BucketCount = 0;
+            other.m_Count = 0;
+        }
+
+        inline void SetControl(u32 bucket, u8 value)
+        {
+            m_Control[bucket] = value;
+            if (bucket < GroupWidth)
+                m_Control[m_BucketCount + bucket] = value;
+        }
+
+        inline u32 GetMask() const { return m_BucketCount - 1; }
+
+        // Leaves at least one bucket empty at every size, which is what lets probing terminate
+        inline static u32 GetMaxLoad(u32 bucketCount) { return bucketCount - bucketCount / 8; }
+
+        inline static u32 GetBucketCountFor(u32 count)
+        {
+            u32 bucketCount = MinimumBucketCount;
+            while (GetMaxLoad(bucketCount) < count)
+                bucketCount *= 2;
+            return bucketCount;
+        }
+
+        // Fibonacci hashing spreads out keys that differ only in their low bits (i.e. entity ids)
+        inline static u32 HashKey(const K& key)
+        {
+            return static_cast<u32>((static_cast<u64>(Hash()(key)) * 11400714819323198485ull) >> 32);
+        }
+
+        inline static u8 GetFingerprint(u32 hash) { return static_cast<u8>(hash >> 25); }
+
+        // Bit i of the result is set when control[i] == value
+        inline static u32 MatchByte(const u8* control, u8 value)
+        {
+            #ifdef HE_FLAT_TABLE_SSE2
+                __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+                return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(value)))));
+            #else
+                u32 result = 0;
+                for (u32 i = 0; i < GroupWidth; i++)
+                    result |= static_cast<u32>(control[i] == value) << i;
+                return result;
+            #endif
+        }
+
+        // Only empty control bytes have their top bit set
+        inline static u32 MatchEmpty(const u8* control)
+        {
+            #ifdef HE_FLAT_TABLE_SSE2
+                return static_cast<u32>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))));
+            #else
+                u32 result = 0;
+                for (u32 i = 0; i < GroupWidth; i++)
+                    result |= static_cast<u32>(control[i] >> 7) << i;
+                return result;
+            #endif
+        }
+
+        // Value must not be zero
+        inline static u32 CountTrailingZeros(u32 value)
+        {
+            #ifdef _MSC_VER
+                unsigned long index;
+                _BitScanForward(&index, value);
+                return static_cast<u32>(index);
+            #else
+                return static_cast<u32>(__builtin_ctz(value));
+            #endif
+        }
+
+    private:
+        inline static constexpr u8 EmptyControl = 0x80;
+        inline static constexpr u32 GroupWidth = 16;
+        inline static constexpr u32 GroupMask = (1 << GroupWidth) - 1;
+        inline static constexpr u32 MinimumBucketCount = 16;
+        inline static constexpr u32 InvalidBucket = std::numeric_limits<u32>::max();
+        inline static constexpr bool m_ShouldDestruct = !std::is_trivially_destructible<E>::value;
+        // std::pair is never trivially copyable, but copy constructing one can still be trivial
+        inline static constexpr bool m_CanMemcpy = std::is_trivially_copy_constructible<E>::value && !m_ShouldDestruct;
+
+    private:
+        E* m_Entries = nullptr;
+        u8* m_Control = nullptr; // Points into the same allocation as m_Entries
+        u32 m_BucketCount = 0;
+        u32 m_Count = 0;
+    };
+
+    // Drop in replacement for std::unordered_map on hot paths. Entries move whenever the map grows or
+    // something is removed, so pointers and references into the map only last until the next insert
+    // or remove. Iteration order is unspecified
+    template <typename K, typename V, typename Hash = std::hash<K>>
+    class HFlatMap : public HFlatTable<K, std::pair<const K, V>, Hash>
+    {
+    public:
+        using Entry = std::pair<const K, V>;
+
+    public:
+        HFlatMap() = default;
+
+        HFlatMap(std::initializer_list<Entry> list)
+        {
+            this->Reserve(static_cast<u32>(list.size()));
+            for (auto& entry : list)
+                Insert(entry.first, entry.second);
+        }
+
+        V& operator[](const K& key)
+        {
+            auto [entry, inserted] = this->FindOrPrepareInsert(key);
+            if (inserted)
+                HE_PLACEMENT_NEW(entry, Entry, key, V());
+            return entry->second;
+        }
+
+        // Key must exist
+        V& Get(const K& key) const
+        {
+            Entry* entry = this->FindEntry(key);
+            HE_ENGINE_ASSERT(entry, "HFlatMap key does not exist");
+            return entry->second;
+        }
+
+        // Returns a pointer to the value for key, or nullptr if there isn't one
+        V* Find(const K& key) const
+        {
+            Entry* entry = this->FindEntry(key);
+            return entry ? &entry->second : nullptr;
+        }
+
+        // Leaves the existing value alone and returns false if key is already present
+        bool Insert(const K& key, const V& value)
+        {
+            auto [entry, inserted] = this->FindOrPrepareInsert(key);
+            if (inserted)
+                HE_PLACEMENT_NEW(entry, Entry, key, value);
+            return inserted;
+        }
+    };
+
+    template <typename K, typename V, typename Hash>
+    struct IsTriviallyRelocatable<HFlatMap<K, V, Hash>> : std::true_type {};
+}
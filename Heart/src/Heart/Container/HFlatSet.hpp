@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Heart/Container/HFlatMap.hpp"
+
+namespace Heart
+{
+    // Set counterpart to HFlatMap with the same storage and the same caveats: keys move on insert
+    // and remove, and iteration order is unspecified
+    template <typename K, typename Hash = std::hash<K>>
+    class HFlatSet : public HFlatTable<K, K, Hash>
+    {
+    public:
+        HFlatSet() = default;
+
+        HFlatSet(std::initializer_list<K> list)
+        {
+            this->Reserve(static_cast<u32>(list.size()));
+            for (auto& key : list)
+                Insert(key);
+        }
+
+        // Returns false if key is already present
+        bool Insert(const K& key)
+        {
+            auto [entry, inserted] = this->FindOrPrepareInsert(key);
+            if (inserted)
+                HE_PLACEMENT_NEW(entry, K, key);
+            return inserted;
+        }
+    };
+
+    template <typename K, typename Hash>
+    struct IsTriviallyRelocatable<HFlatSet<K, Hash>> : std::true_type {};
+}
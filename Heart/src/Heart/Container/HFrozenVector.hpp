@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+
+namespace Heart
+{
+    // Read only array where every copy shares the same buffer, so it can be copied and handed to
+    // other threads for the cost of a reference count. Building one from an HVector copies the
+    // elements once, or not at all when the vector is moved in
+    template <typename T>
+    class HFrozenVector
+    {
+    public:
+        HFrozenVector() = default;
+        ~HFrozenVector() = default;
+
+        HFrozenVector(const HFrozenVector& other)
+        {
+            m_Vector.ShallowCopy(other.m_Vector);
+        }
+
+        HFrozenVector(HFrozenVector&& other)
+            : m_Vector(std::move(other.m_Vector))
+        {}
+
+        HFrozenVector(const HVector<T>& vector)
+            : m_Vector(vector)
+        {}
+
+        HFrozenVector(HVector<T>&& vector)
+            : m_Vector(std::move(vector))
+        {}
+
+        HFrozenVector(std::initializer_list<T> list)
+            : m_Vector(list)
+        {}
+
+        // Mutable copy of the elements
+        inline HVector<T> Thaw() const { return m_Vector.Clone(); }
+
+        inline u32 Count() const { return m_Vector.Count(); }
+        inline u32 GetRefCount() const { return m_Vector.GetRefCount(); }
+        inline const T* Data() const { return m_Vector.Data(); }
+        inline const T* Begin() const { return m_Vector.Begin(); }
+        inline const T* End() const { return m_Vector.End(); }
+        inline const T& Front() const { return m_Vector.Front(); }
+        inline const T& Back() const { return m_Vector.Back(); }
+        inline const T& Get(u32 index) const { return m_Vector.Get(index); }
+        inline bool IsEmpty() const { return m_Vector.IsEmpty(); }
+
+        inline const T& operator[](u32 index) const { return m_Vector[index]; }
+        inline void operator=(const HFrozenVector& other) { m_Vector.ShallowCopy(other.m_Vector); }
+
+        // For range loops
+        inline const T* begin() const { return Begin(); }
+        inline const T* end() const { return End(); }
+
+    private:
+        HVector<T> m_Vector;
+    };
+
+    template <typename T>
+    struct IsTriviallyRelocatable<HFrozenVector<T>> : std::true_type {};
+}
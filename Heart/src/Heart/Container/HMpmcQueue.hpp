@@ -0,0 +1,135 @@
+#pragma once
+
+namespace Heart
+{
+    // Bounded lock-free FIFO ring buffer for any number of producer and consumer threads
+    // https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+    //
+    // Every slot carries a sequence number that tells a thread whether the slot is ready for the
+    // lap it is on, so claiming a slot is a single CAS on the shared cursor and the element is
+    // constructed or moved out without holding anything
+    template <typename T>
+    class HMpmcQueue
+    {
+    public:
+        // Capacity is rounded up to a power of two
+        HMpmcQueue(u32 capacity = 1024)
+        {
+            u32 slotCount = GetNextPowerOfTwo(capacity);
+            m_Mask = slotCount - 1;
+            m_Slots = reinterpret_cast<Slot*>(::operator new(slotCount * sizeof(Slot), std::align_val_t(alignof(Slot))));
+            for (u32 i = 0; i < slotCount; i++)
+                HE_PLACEMENT_NEW(&m_Slots[i].Sequence, std::atomic<u64>, i);
+        }
+
+        ~HMpmcQueue()
+        {
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                u64 tail = m_Tail.load(std::memory_order_relaxed);
+                for (u64 i = m_Head.load(std::memory_order_relaxed); i != tail; i++)
+                    m_Slots[i & m_Mask].Get()->~T();
+            }
+            ::operator delete(m_Slots, std::align_val_t(alignof(Slot)));
+        }
+
+        HMpmcQueue(const HMpmcQueue&) = delete;
+        HMpmcQueue& operator=(const HMpmcQueue&) = delete;
+
+        // Any thread. Returns false if the queue is full
+        template <typename... Args>
+        bool Emplace(Args&&... args)
+        {
+            u64 tail = m_Tail.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = m_Slots[tail & m_Mask];
+                s64 lap = (s64)(slot.Sequence.load(std::memory_order_acquire) - tail);
+                if (lap == 0)
+                {
+                    // The slot was emptied for this lap, so race the other producers for it
+                    if (m_Tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                    {
+                        HE_PLACEMENT_NEW(slot.Get(), T, std::forward<Args>(args)...);
+                        slot.Sequence.store(tail + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lap < 0)
+                    return false; // Still holds the element from the previous lap
+                else
+                    tail = m_Tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        inline bool Push(const T& value) { return Emplace(value); }
+        inline bool Push(T&& value) { return Emplace(std::move(value)); }
+
+        // Any thread. Returns false if the queue is empty
+        bool Pop(T& out)
+        {
+            u64 head = m_Head.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = m_Slots[head & m_Mask];
+                s64 lap = (s64)(slot.Sequence.load(std::memory_order_acquire) - (head + 1));
+                if (lap == 0)
+                {
+                    if (m_Head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                    {
+                        T* value = slot.Get();
+                        out = std::move(*value);
+                        value->~T();
+                        // Hand the slot to the producers of the next lap
+                        slot.Sequence.store(head + m_Mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lap < 0)
+                    return false; // Not written yet
+                else
+                    head = m_Head.load(std::memory_order_relaxed);
+            }
+        }
+
+        inline u32 CountApprox() const
+        {
+            u64 count = m_Tail.load(std::memory_order_relaxed) - m_Head.load(std::memory_order_relaxed);
+            return count > m_Mask + 1 ? 0 : static_cast<u32>(count);
+        }
+        inline bool IsEmptyApprox() const { return CountApprox() == 0; }
+        inline u32 GetCapacity() const { return m_Mask + 1; }
+
+    private:
+        struct Slot
+        {
+            inline T* Get() { return reinterpret_cast<T*>(Storage); }
+
+            std::atomic<u64> Sequence;
+            alignas(T) u8 Storage[sizeof(T)];
+        };
+
+    private:
+        static u32 GetNextPowerOfTwo(u32 value)
+        {
+            u32 two = std::max(value, 2u) - 1;
+            two |= two >> 1;
+            two |= two >> 2;
+            two |= two >> 4;
+            two |= two >> 8;
+            two |= two >> 16;
+            return ++two;
+        }
+
+        inline static constexpr u32 CacheLineSize = 64;
+
+    private:
+        // Producers only touch the tail and consumers only touch the head
+        std::atomic<u64> m_Head = 0;
+        u8 m_HeadPadding[CacheLineSize - sizeof(std::atomic<u64>)];
+        std::atomic<u64> m_Tail = 0;
+        u8 m_TailPadding[CacheLineSize - sizeof(std::atomic<u64>)];
+        Slot* m_Slots;
+        u32 m_Mask;
+    };
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+
+namespace Heart
+{
+    // Unbounded lock-free FIFO queue for any number of producer threads and a single consumer
+    // thread. Elements live in fixed size segments that are linked together as the queue grows,
+    // so pushing never fails and only allocates once per SegmentSize elements
+    //
+    // Producers claim a slot with one fetch_add on the tail segment and publish it with a flag,
+    // which means a slow producer can briefly hide the elements pushed after it. Segments the
+    // consumer has finished with are freed once no push is in flight, since a producer may still
+    // be holding on to an old tail segment until then
+    template <typename T, u32 SegmentSize = 256>
+    class HMpscQueue
+    {
+    public:
+        HMpscQueue()
+        {
+            m_Head = new Segment();
+            m_Tail.store(m_Head, std::memory_order_relaxed);
+        }
+
+        ~HMpscQueue()
+        {
+            while (Front())
+                PopFront();
+
+            FreeRetiredSegments(true);
+            delete m_Head;
+        }
+
+        HMpscQueue(const HMpscQueue&) = delete;
+        HMpscQueue& operator=(const HMpscQueue&) = delete;
+
+        // Any thread
+        template <typename... Args>
+        void Emplace(Args&&... args)
+        {
+            m_PushesInFlight.fetch_add(1);
+
+            Segment* tail = m_Tail.load();
+            while (true)
+            {
+                u32 index = tail->Reserved.fetch_add(1, std::memory_order_relaxed);
+                if (index < SegmentSize)
+                {
+                    Slot& slot = tail->Slots[index];
+                    HE_PLACEMENT_NEW(slot.Get(), T, std::forward<Args>(args)...);
+                    slot.Ready.store(true, std::memory_order_release);
+                    break;
+                }
+
+                // The segment is full, so link a new one unless another producer beat us to it
+                Segment* next = tail->Next.load(std::memory_order_acquire);
+                if (!next)
+                {
+                    Segment* created = new Segment();
+                    if (tail->Next.compare_exchange_strong(next, created, std::memory_order_acq_rel))
+                        next = created;
+                    else
+                        delete created;
+                }
+                m_Tail.compare_exchange_strong(tail, next);
+                tail = m_Tail.load();
+            }
+
+            m_PushesInFlight.fetch_sub(1);
+        }
+
+        inline void Push(const T& value) { Emplace(value); }
+        inline void Push(T&& value) { Emplace(std::move(value)); }
+
+        // Consumer thread only. Returns false if the queue is empty
+        bool Pop(T& out)
+        {
+            T* value = Front();
+            if (!value)
+                return false;
+
+            out = std::move(*value);
+            PopFront();
+            return true;
+        }
+
+        // Consumer thread only. Calls func on each element that is ready, in order, and returns
+        // how many were consumed
+        template <typename Func>
+        u32 Drain(Func&& func)
+        {
+            u32 count = 0;
+            while (T* value = Front())
+            {
+                func(*value);
+                PopFront();
+                count++;
+            }
+            return count;
+        }
+
+    private:
+        struct Slot
+        {
+            inline T* Get() { return reinterpret_cast<T*>(Storage); }
+
+            std::atomic<bool> Ready = false;
+            alignas(T) u8 Storage[sizeof(T)];
+        };
+
+        struct Segment
+        {
+            std::atomic<u32> Reserved = 0;
+            std::atomic<Segment*> Next = nullptr;
+            Slot Slots[SegmentSize];
+        };
+
+    private:
+        // The oldest element if it has been published, moving on to the next segment when the
+        // current one has been used up
+        T* Front()
+        {
+            if (m_HeadIndex == SegmentSize)
+            {
+                Segment* next = m_Head->Next.load(std::memory_order_acquire);
+                if (!next)
+                    return nullptr;
+
+                m_RetiredSegments.Add(m_Head);
+                m_Head = next;
+                m_HeadIndex = 0;
+                FreeRetiredSegments(false);
+            }
+
+            Slot& slot = m_Head->Slots[m_HeadIndex];
+            if (!slot.Ready.load(std::memory_order_acquire))
+                return nullptr;
+            return slot.Get();
+        }
+
+        // Destroys the element returned by Front
+        inline void PopFront()
+        {
+            m_Head->Slots[m_HeadIndex++].Get()->~T();
+        }
+
+        void FreeRetiredSegments(bool force)
+        {
+            // Every producer that could still see a retired segment as the tail loaded it while
+            // its push was in flight. Once none are, the tail has moved past all of them for good
+            if (!force && m_PushesInFlight.load() != 0)
+                return;
+
+            for (Segment* segment : m_RetiredSegments)
+                delete segment;
+            m_RetiredSegments.Clear();
+        }
+
+        inline static constexpr u32 CacheLineSize = 64;
+
+    private:
+        std::atomic<u32> m_PushesInFlight = 0;
+        std::atomic<Segment*> m_Tail;
+        u8 m_TailPadding[CacheLineSize - sizeof(std::atomic<u32>) - sizeof(std::atomic<Segment*>)];
+        // Consumer only
+        Segment* m_Head;
+        u32 m_HeadIndex = 0;
+        HVector<Segment*> m_RetiredSegments;
+    };
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "Heart/Container/Container.hpp"
+
+namespace Heart
+{
+    // Same interface as HVector, but the first N elements live inside the object so small vectors
+    // never touch the allocator. Grows onto the heap once it holds more than N. Copies are always
+    // deep since there is no shared header to reference count. No pointer into the inline storage is
+    // ever kept, so the vector is trivially relocatable whenever its elements are
+    template <typename T, u32 N>
+    class HSmallVector
+    {
+        static_assert(N > 0, "HSmallVector must have room for at least one element");
+
+    public:
+        HSmallVector() = default;
+
+        ~HSmallVector()
+        {
+            Clear(true);
+        }
+
+        HSmallVector(const HSmallVector& other)
+        {
+            CopyFrom(other.Begin(), other.End());
+        }
+
+        HSmallVector(HSmallVector&& other)
+        {
+            Take(other);
+        }
+
+        HSmallVector(u32 elemCount, bool fill = true)
+        {
+            if (fill)
+                Resize(elemCount, true);
+            else
+                Reserve(elemCount);
+        }
+
+        HSmallVector(const T* data, u32 dataCount)
+        {
+            CopyFrom(data, data + dataCount);
+        }
+
+        HSmallVector(std::initializer_list<T> list)
+        {
+            CopyFrom(list.begin(), list.end());
+        }
+
+        HSmallVector(const T* start, const T* end)
+        {
+            CopyFrom(start, end);
+        }
+
+        void Add(const T& elem)
+        {
+            // Copy first in case elem lives inside of this vector
+            if (m_Count == m_Capacity)
+            {
+                T copy(elem);
+                Grow(m_Count + 1);
+                HE_PLACEMENT_NEW(Data() + m_Count, T, std::move(copy));
+            }
+            else
+                HE_PLACEMENT_NEW(Data() + m_Count, T, elem);
+            m_Count++;
+        }
+
+        template <class... Args>
+        void AddInPlace(Args... args)
+        {
+            if (m_Count == m_Capacity)
+                Grow(m_Count + 1);
+            HE_PLACEMENT_NEW(Data() + m_Count, T, std::forward<Args>(args)...);
+            m_Count++;
+        }
+
+        void Remove(u32 index)
+        {
+            if (index >= m_Count) throw std::out_of_range("Called Remove() on container with out of range index");
+
+            T* data = Data();
+            if constexpr (m_ShouldDestruct)
+                data[index].~T();
+
+            m_Count--;
+            RelocateElements(data + index, data + index + 1, m_Count - index);
+        }
+
+        void RemoveUnordered(u32 index)
+        {
+            if (index >= m_Count) throw std::out_of_range("Called Remove() on container with out of range index");
+
+            T* data = Data();
+            if constexpr (m_ShouldDestruct)
+                data[index].~T();
+
+            m_Count--;
+            if (index != m_Count)
+                RelocateElements(data + index, data + m_Count, 1);
+        }
+
+        void Pop()
+        {
+            if (m_Count == 0) throw std::out_of_range("Called Pop() on container with a count of zero");
+
+            m_Count--;
+            if constexpr (m_ShouldDestruct)
+                Data()[m_Count].~T();
+        }
+
+        void CopyFrom(const T* start, const T* end)
+        {
+            Clear();
+
+            u32 count = static_cast<u32>(end - start);
+            Reserve(count);
+            T* data = Data();
+            if constexpr (m_CanMemcpy)
+            {
+                if (count > 0)
+                    memcpy(data, start, count * sizeof(T));
+            }
+            else
+            {
+                for (u32 i = 0; i < count; i++)
+                    HE_PLACEMENT_NEW(data + i, T, start[i]);
+            }
+            m_Count = count;
+        }
+
+        void Insert(const HSmallVector& other, u32 index)
+        {
+            HE_ENGINE_ASSERT(&other != this, "Cannot insert an HSmallVector into itself");
+
+            u32 otherCount = other.Count();
+            index = std::min(index, m_Count);
+            Reserve(m_Count + otherCount);
+
+            T* data = Data();
+            RelocateElements(data + index + otherCount, data + index, m_Count - index);
+            for (u32 i = 0; i < otherCount; i++)
+                HE_PLACEMENT_NEW(data + index + i, T, other[i]);
+            m_Count += otherCount;
+        }
+
+        void Insert(const T& elem, u32 index)
+        {
+            T copy(elem);
+            if (m_Count == m_Capacity)
+                Grow(m_Count + 1);
+
+            T* data = Data();
+            index = std::min(index, m_Count);
+            RelocateElements(data + index + 1, data + index, m_Count - index);
+
+            HE_PLACEMENT_NEW(data + index, T, std::move(copy));
+            m_Count++;
+        }
+
+        void Append(const HSmallVector& other)
+        {
+            Insert(other, m_Count);
+        }
+
+        void Reserve(u32 allocCount)
+        {
+            if (allocCount > m_Capacity)
+                Grow(allocCount);
+        }
+
+        // Shrinking moves the elements back inline when they fit
+        void Clear(bool shrink = false)
+        {
+            Trim(0);
+            if (shrink && !IsInline())
+            {
+                ::operator delete(m_Heap);
+                m_Capacity = N;
+            }
+        }
+
+        // Shrink the count without shrinking memory
+        void Trim(u32 newCount)
+        {
+            if (newCount >= m_Count) return;
+
+            if constexpr (m_ShouldDestruct)
+            {
+                T* data = Data();
+                for (u32 i = newCount; i < m_Count; i++)
+                    data[i].~T();
+            }
+
+            m_Count = newCount;
+        }
+
+        // Unlike HVector this never shrinks the allocation, use Clear(true) for that
+        void Resize(u32 elemCount, bool construct = true)
+        {
+            if (elemCount <= m_Count)
+            {
+                Trim(elemCount);
+                return;
+            }
+
+            Reserve(elemCount);
+
+            // Zero out the memory if the default constructors are not run to match HVector
+            T* data = Data();
+            bool constructed = false;
+            if constexpr (m_ShouldConstruct)
+            {
+                if (construct)
+                {
+                    for (u32 i = m_Count; i < elemCount; i++)
+                        HE_PLACEMENT_NEW(data + i, T);
+                    constructed = true;
+                }
+            }
+            if (!constructed)
+                memset(data + m_Count, 0, (elemCount - m_Count) * sizeof(T));
+
+            m_Count = elemCount;
+        }
+
+        inline HSmallVector Clone() const { return HSmallVector(*this); }
+        inline u32 Count() const { return m_Count; }
+        inline u32 GetAllocatedCount() const { return m_Capacity; }
+        inline T* Data() const { return IsInline() ? reinterpret_cast<T*>(const_cast<u8*>(m_Inline)) : m_Heap; }
+        inline T* Begin() const { return Data(); }
+        inline T* End() const { return Data() + m_Count; }
+        inline T& Front() const { return *Begin(); }
+        inline T& Back() const { return *(End() - 1); }
+        inline T& Get(u32 index) const
+        { HE_ENGINE_ASSERT(index < m_Count, "Container access out of bounds"); return Data()[index]; }
+        inline bool IsEmpty() const { return m_Count == 0; }
+
+        // Whether the elements are still stored inside of the object
+        inline bool IsInline() const { return m_Capacity == N; }
+
+        inline T& operator[](u32 index) const { return Get(index); }
+
+        inline void operator=(const HSmallVector& other)
+        {
+            if (&other != this)
+                CopyFrom(other.Begin(), other.End());
+        }
+
+        inline void operator=(HSmallVector&& other)
+        {
+            if (&other == this) return;
+            Clear(true);
+            Take(other);
+        }
+
+        // For range loops
+        inline T* begin() const { return Begin(); }
+        inline T* end() const { return End(); }
+
+        inline static constexpr u32 InlineCount = N;
+
+    private:
+        void Grow(u32 minCount)
+        {
+            // Heap capacities are always larger than N, which is what tells the two apart
+            u32 capacity = std::max(minCount, m_Capacity * 2);
+            T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+            RelocateElements(data, Data(), m_Count);
+            if (!IsInline())
+                ::operator delete(m_Heap);
+
+            m_Heap = data;
+            m_Capacity = capacity;
+        }
+
+        void Take(HSmallVector& other)
+        {
+            if (other.IsInline())
+                RelocateElements(reinterpret_cast<T*>(m_Inline), other.Data(), other.m_Count);
+            else
+                m_Heap = other.m_Heap;
+            m_Count = other.m_Count;
+            m_Capacity = other.m_Capacity;
+
+            other.m_Count = 0;
+            other.m_Capacity = N;
+        }
+
+        inline static constexpr bool m_ShouldDestruct = std::is_destructible<T>::value && !std::is_trivially_destructible<T>::value;
+        inline static constexpr bool m_ShouldConstruct = std::is_default_constructible<T>::value;
+        inline static constexpr bool m_CanMemcpy = std::is_trivially_copyable<T>::value;
+
+    private:
+        union
+        {
+            T* m_Heap;
+            alignas(T) u8 m_Inline[N * sizeof(T)];
+        };
+        u32 m_Count = 0;
+        u32 m_Capacity = N;
+    };
+
+    template <typename T, u32 N>
+    struct IsTriviallyRelocatable<HSmallVector<T, N>> : IsTriviallyRelocatable<T> {};
+}
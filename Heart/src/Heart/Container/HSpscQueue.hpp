@@ -0,0 +1,109 @@
+#pragma once
+
+namespace Heart
+{
+    // Bounded lock-free FIFO ring buffer for exactly one producer thread and one consumer thread
+    // https://rigtorp.se/ringbuffer/
+    //
+    // Each side keeps a cached copy of the other side's cursor and only reloads it when the queue
+    // looks full or empty, so in steady state neither thread touches the other's cache line
+    template <typename T>
+    class HSpscQueue
+    {
+    public:
+        // Capacity is rounded up to a power of two
+        HSpscQueue(u32 capacity = 1024)
+        {
+            u32 slotCount = GetNextPowerOfTwo(capacity);
+            m_Mask = slotCount - 1;
+            m_Slots = reinterpret_cast<T*>(::operator new(slotCount * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        ~HSpscQueue()
+        {
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                u64 tail = m_Tail.load(std::memory_order_relaxed);
+                for (u64 i = m_Head.load(std::memory_order_relaxed); i != tail; i++)
+                    m_Slots[i & m_Mask].~T();
+            }
+            ::operator delete(m_Slots, std::align_val_t(alignof(T)));
+        }
+
+        HSpscQueue(const HSpscQueue&) = delete;
+        HSpscQueue& operator=(const HSpscQueue&) = delete;
+
+        // Producer thread only. Returns false if the queue is full
+        template <typename... Args>
+        bool Emplace(Args&&... args)
+        {
+            u64 tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail - m_CachedHead > m_Mask)
+            {
+                m_CachedHead = m_Head.load(std::memory_order_acquire);
+                if (tail - m_CachedHead > m_Mask)
+                    return false;
+            }
+
+            HE_PLACEMENT_NEW(m_Slots + (tail & m_Mask), T, std::forward<Args>(args)...);
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        inline bool Push(const T& value) { return Emplace(value); }
+        inline bool Push(T&& value) { return Emplace(std::move(value)); }
+
+        // Consumer thread only. Returns false if the queue is empty
+        bool Pop(T& out)
+        {
+            u64 head = m_Head.load(std::memory_order_relaxed);
+            if (head == m_CachedTail)
+            {
+                m_CachedTail = m_Tail.load(std::memory_order_acquire);
+                if (head == m_CachedTail)
+                    return false;
+            }
+
+            T& slot = m_Slots[head & m_Mask];
+            out = std::move(slot);
+            slot.~T();
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        inline u32 CountApprox() const
+        {
+            u64 count = m_Tail.load(std::memory_order_relaxed) - m_Head.load(std::memory_order_relaxed);
+            // The cursors are read separately so the difference can briefly wrap
+            return count > m_Mask + 1 ? 0 : static_cast<u32>(count);
+        }
+        inline bool IsEmptyApprox() const { return CountApprox() == 0; }
+        inline u32 GetCapacity() const { return m_Mask + 1; }
+
+    private:
+        static u32 GetNextPowerOfTwo(u32 value)
+        {
+            u32 two = std::max(value, 2u) - 1;
+            two |= two >> 1;
+            two |= two >> 2;
+            two |= two >> 4;
+            two |= two >> 8;
+            two |= two >> 16;
+            return ++two;
+        }
+
+        inline static constexpr u32 CacheLineSize = 64;
+
+    private:
+        // Each cursor shares a line only with the cache its own thread reads, which avoids
+        // over-aligned storage for the same reasons as WorkStealingDeque
+        std::atomic<u64> m_Head = 0;
+        u64 m_CachedTail = 0;
+        u8 m_HeadPadding[CacheLineSize - sizeof(std::atomic<u64>) - sizeof(u64)];
+        std::atomic<u64> m_Tail = 0;
+        u64 m_CachedHead = 0;
+        u8 m_TailPadding[CacheLineSize - sizeof(std::atomic<u64>) - sizeof(u64)];
+        T* m_Slots;
+        u32 m_Mask;
+    };
+}
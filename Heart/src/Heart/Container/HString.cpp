@@ -1,7 +1,7 @@
 #include "hepch.h"
 #include "HString.h"
 
-#include "ww898/utf_converters.hpp"
+#include "Heart/Util/UTFUtils.h"
 
 namespace Heart
 {
@@ -17,6 +17,23 @@ namespace Heart
         HE_ENGINE_ASSERT(false, "HString from HStringView constructor not fully implemented");
     }
 
+    template <typename T>
+    HString HString::Transcode(const T* str, u32 len)
+    {
+        if constexpr (std::is_same<T, char16>::value)
+        {
+            HString result(Encoding::UTF8);
+            UTFUtils::ConvertUTF16ToUTF8(str, len, result.AllocateUninitialized<char8>(UTFUtils::GetUTF8Length(str, len)));
+            return result;
+        }
+        else
+        {
+            HString result(Encoding::UTF16);
+            UTFUtils::ConvertUTF8ToUTF16(str, len, result.AllocateUninitialized<char16>(UTFUtils::GetUTF16Length(str, len)));
+            return result;
+        }
+    }
+
     u32 HString::Count() const
     {
         switch (m_Encoding)
@@ -40,14 +57,14 @@ namespace Heart
             {
                 switch (m_Encoding)
                 {
-                    case Encoding::UTF16: return HString(ww898::utf::convz<char8>(DataUTF16()));
+                    case Encoding::UTF16: return Transcode(DataUTF16(), CountUTF16());
                 }
             }
             case Encoding::UTF16:
             {
                 switch (m_Encoding)
                 {
-                    case Encoding::UTF8: return HString(ww898::utf::convz<char16>(DataUTF8()));
+                    case Encoding::UTF8: return Transcode(DataUTF8(), CountUTF8());
                 }
             }
         }
@@ -61,12 +78,10 @@ namespace Heart
         if (m_Encoding == Encoding::UTF8)
             return HString8(DataUTF8(), CountUTF8());
 
-        // Not optimal because the converted string is being allocated twice,
-        // but it's fine for now
         switch (m_Encoding)
         {
             case Encoding::UTF16:
-            { return HString8(ww898::utf::convz<char8>(DataUTF16())); }
+            { return HString8(HStringTyped<char8>::Transcode(DataUTF16(), CountUTF16())); }
         }
 
         HE_ENGINE_ASSERT(false, "HString ToUTF8() not fully implemented");
@@ -78,12 +93,10 @@ namespace Heart
         if (m_Encoding == Encoding::UTF16)
             return HString16(DataUTF16(), CountUTF16());
 
-        // Not optimal because the converted string is being allocated twice,
-        // but it's fine for now
         switch (m_Encoding)
         {
             case Encoding::UTF8:
-            { return HString16(ww898::utf::convz<char16>(DataUTF8())); }
+            { return HString16(HStringTyped<char16>::Transcode(DataUTF8(), CountUTF8())); }
         }
 
         HE_ENGINE_ASSERT(false, "HString ToUTF16() not fully implemented");
@@ -280,14 +293,14 @@ namespace Heart
             {
                 switch (m_Encoding)
                 {
-                    case HString::Encoding::UTF16: return HString(ww898::utf::convz<char8>(DataUTF16()));
+                    case HString::Encoding::UTF16: return HString::Transcode(DataUTF16(), CountUTF16());
                 }
             }
             case HString::Encoding::UTF16:
             {
                 switch (m_Encoding)
                 {
-                    case HString::Encoding::UTF8: return HString(ww898::utf::convz<char16>(DataUTF8()));
+                    case HString::Encoding::UTF8: return HString::Transcode(DataUTF8(), CountUTF8());
                 }
             }
         }
@@ -295,4 +308,18 @@ namespace Heart
         HE_ENGINE_ASSERT(false, "HStringView Convert() not fully implemented");
         return HString();
     }
-}
+
+    HString8 HStringView::ToUTF8() const
+    {
+        if (m_Encoding == HString::Encoding::UTF16)
+            return HString8(HStringTyped<char8>::Transcode(DataUTF16(), CountUTF16()));
+        return HString8(DataUTF8(), CountUTF8());
+    }
+
+    HString16 HStringView::ToUTF16() const
+    {
+        if (m_Encoding == HString::Encoding::UTF8)
+            return HString16(HStringTyped<char16>::Transcode(DataUTF8(), CountUTF8()));
+        return HString16(DataUTF16(), CountUTF16());
+    }
+}
\ No newline at end of file
@@ -156,6 +156,19 @@ namespace Heart
                     reinterpret_cast<T*>(m_Container.Data())[dataIndex++] = strs[i][j];
         }
 
+        template <typename T>
+        T* AllocateUninitialized(u32 len)
+        {
+            // Resizing without constructing zeroes the buffer, which also places the terminator
+            m_Container.Clear(true);
+            m_Container.Resize((len + 1) * sizeof(T), false);
+            return reinterpret_cast<T*>(m_Container.Data());
+        }
+
+        // Converts a string of the other encoding with a single allocation
+        template <typename T>
+        static HString Transcode(const T* str, u32 len);
+
         template <typename T>
         HString AddPtr(const T* other, bool prepend) const
         {
@@ -240,8 +253,8 @@ namespace Heart
         constexpr int Compare(StringComparison type, const HStringView& other) const;
         HString Convert(HString::Encoding encoding) const;
 
-        inline HString8 ToUTF8() const { return HString8(DataUTF8(), CountUTF8()); }
-        inline HString16 ToUTF16() const { return HString16(DataUTF16(), CountUTF16()); }
+        HString8 ToUTF8() const;
+        HString16 ToUTF16() const;
 
         template <typename T>
         inline constexpr const T* Data() const
@@ -286,6 +299,9 @@ namespace Heart
         friend class HString;
     };
 
+    template <>
+    struct IsTriviallyRelocatable<HString> : std::true_type {};
+
     void to_json(nlohmann::json& j, const HString& str);
     void from_json(const nlohmann::json& j, HString& str);
 
@@ -2,7 +2,6 @@
 #include "HString16.h"
 
 #include "Heart/Container/HString.h"
-#include "ww898/utf_converters.hpp"
 
 namespace Heart
 {
@@ -17,12 +16,12 @@ namespace Heart
 
     HString8 HString16::ToUTF8() const
     {
-        return HString8(ww898::utf::convz<char8>(Data()));
+        return HString8(HStringTyped<char8>::Transcode(Data(), Count()));
     }
 
     HString8 HStringView16::ToUTF8() const
     {
-        return HString8(ww898::utf::convz<char8>(Data()));
+        return HString8(HStringTyped<char8>::Transcode(Data(), Count()));
     }
 
     template <>
@@ -81,6 +81,9 @@ namespace Heart
         HString8 ToUTF8() const;
     };
 
+    template <>
+    struct IsTriviallyRelocatable<HString16> : std::true_type {};
+
     void to_json(nlohmann::json& j, HStringView16 str);
     // void from_json(const nlohmann::json& j, HStringView16& str);
     // void from_json(const nlohmann::json& j, HString16& str);
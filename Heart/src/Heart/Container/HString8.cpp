@@ -2,7 +2,6 @@
 #include "HString8.h"
 
 #include "Heart/Container/HString.h"
-#include "ww898/utf_converters.hpp"
 
 namespace Heart
 {
@@ -17,12 +16,12 @@ namespace Heart
 
     HString16 HString8::ToUTF16() const
     {
-        return HString16(ww898::utf::convz<char16>(Data()));
+        return HString16(HStringTyped<char16>::Transcode(Data(), Count()));
     }
 
     HString16 HStringView8::ToUTF16() const
     {
-        return HString16(ww898::utf::convz<char16>(Data()));
+        return HString16(HStringTyped<char16>::Transcode(Data(), Count()));
     }
 
     template <>
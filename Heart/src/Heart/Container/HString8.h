@@ -81,6 +81,9 @@ namespace Heart
         HString16 ToUTF16() const;
     };
 
+    template <>
+    struct IsTriviallyRelocatable<HString8> : std::true_type {};
+
     void to_json(nlohmann::json& j, HStringView8 str);
     void from_json(const nlohmann::json& j, HStringView8& str);
     void from_json(const nlohmann::json& j, HString8& str);
@@ -0,0 +1,75 @@
+#include "hepch.h"
+#include "HStringId.h"
+
+namespace Heart
+{
+    HStringId::HStringId(HStringView8 str)
+    {
+        if (str.Count() == 0) return;
+
+        std::basic_string_view<char8> view(str.Data(), str.Count());
+        {
+            std::shared_lock lock(s_Mutex);
+            *this = FindInternal(view);
+            if (!IsEmpty()) return;
+        }
+
+        std::unique_lock lock(s_Mutex);
+
+        // Another thread may have interned the same string while the lock was released
+        *this = FindInternal(view);
+        if (!IsEmpty()) return;
+
+        u32 id = s_NextId++;
+        HE_ENGINE_ASSERT(id < BlockSize * MaxBlocks, "Too many interned strings");
+
+        auto& blockSlot = s_Blocks[id / BlockSize];
+        Entry* block = blockSlot.load(std::memory_order_relaxed);
+        if (!block)
+        {
+            block = new Entry[BlockSize];
+            blockSlot.store(block, std::memory_order_release);
+        }
+
+        Entry& entry = block[id % BlockSize];
+        entry.String = HString8(str.Data(), str.Count());
+        entry.Hash = static_cast<u32>(std::hash<std::basic_string_view<char8>>{}(view));
+        s_Lookup.emplace(std::basic_string_view<char8>(entry.String.Data(), entry.String.Count()), id);
+
+        m_Id = id;
+        m_Hash = entry.Hash;
+    }
+
+    HStringId HStringId::Find(HStringView8 str)
+    {
+        if (str.Count() == 0) return HStringId();
+
+        std::shared_lock lock(s_Mutex);
+        return FindInternal(std::basic_string_view<char8>(str.Data(), str.Count()));
+    }
+
+    const HString8& HStringId::GetString() const
+    {
+        if (m_Id == 0) return s_EmptyString;
+
+        Entry* block = s_Blocks[m_Id / BlockSize].load(std::memory_order_acquire);
+        return block[m_Id % BlockSize].String;
+    }
+
+    u32 HStringId::GetInternedCount()
+    {
+        std::shared_lock lock(s_Mutex);
+        return s_NextId - 1;
+    }
+
+    HStringId HStringId::FindInternal(std::basic_string_view<char8> str)
+    {
+        HStringId result;
+        auto found = s_Lookup.find(str);
+        if (found == s_Lookup.end()) return result;
+
+        result.m_Id = found->second;
+        result.m_Hash = s_Blocks[result.m_Id / BlockSize].load(std::memory_order_acquire)[result.m_Id % BlockSize].Hash;
+        return result;
+    }
+}
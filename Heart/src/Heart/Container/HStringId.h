@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Heart/Container/HString8.h"
+
+namespace Heart
+{
+    // Handle to a string stored once in a global table, along with its hash. Equal strings always
+    // map to the same id, so comparing and hashing ids costs the same as doing it to an integer.
+    // Creating an id takes a shared lock and a hash of the string, or an exclusive lock the first
+    // time a string is seen, so ids used on hot paths should be created up front and stored.
+    // Interned strings are never freed
+    class HStringId
+    {
+    public:
+        HStringId() = default;
+        HStringId(HStringView8 str);
+
+        HStringId(const HString8& str)
+            : HStringId(HStringView8(str))
+        {}
+
+        HStringId(const char8* str)
+            : HStringId(HStringView8(str))
+        {}
+
+        // Id of str if it has already been interned, or an empty id otherwise. Useful for lookups
+        // that should not grow the table when the string is unknown
+        static HStringId Find(HStringView8 str);
+
+        const HString8& GetString() const;
+
+        inline const char8* Data() const { return GetString().Data(); }
+        inline u32 Count() const { return GetString().Count(); }
+        inline u32 GetId() const { return m_Id; }
+        inline u32 GetHash() const { return m_Hash; }
+        inline bool IsEmpty() const { return m_Id == 0; }
+
+        inline bool operator==(HStringId other) const { return m_Id == other.m_Id; }
+        inline bool operator!=(HStringId other) const { return m_Id != other.m_Id; }
+        // Orders by when strings were first interned rather than alphabetically
+        inline bool operator<(HStringId other) const { return m_Id < other.m_Id; }
+
+        // Number of unique strings interned so far, not counting the empty string
+        static u32 GetInternedCount();
+
+    private:
+        struct Entry
+        {
+            HString8 String;
+            u32 Hash;
+        };
+
+    private:
+        static HStringId FindInternal(std::basic_string_view<char8> str);
+
+    private:
+        // Entries live in fixed size blocks that never move, so strings can be read without a lock
+        inline static constexpr u32 BlockSize = 1024;
+        inline static constexpr u32 MaxBlocks = 4096;
+
+        inline static std::shared_mutex s_Mutex;
+        inline static std::unordered_map<std::basic_string_view<char8>, u32> s_Lookup; // Views into the entries
+        inline static std::atomic<Entry*> s_Blocks[MaxBlocks] = {};
+        inline static u32 s_NextId = 1;
+        inline static const HString8 s_EmptyString;
+
+    private:
+        u32 m_Id = 0; // Zero is always the empty string
+        u32 m_Hash = 0;
+    };
+}
+
+namespace std
+{
+    template<>
+    struct hash<Heart::HStringId>
+    {
+        std::size_t operator()(Heart::HStringId id) const
+        {
+            return id.GetHash();
+        }
+    };
+}
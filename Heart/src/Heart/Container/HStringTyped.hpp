@@ -2,6 +2,7 @@
 
 #include "Heart/Container/Container.hpp"
 #include "Heart/Util/StringUtils.hpp"
+#include "Heart/Util/UTFUtils.h"
 
 namespace Heart
 {
@@ -68,6 +69,11 @@ namespace Heart
         HStringTyped<T> operator+(const HStringViewTyped<T>& other) const;
         void operator+=(const HStringViewTyped<T>& other);
 
+        // Converts a string of the other encoding with a single allocation. Malformed input
+        // is replaced with U+FFFD
+        template <typename U>
+        static HStringTyped<T> Transcode(const U* str, u32 len);
+
         inline static constexpr u32 InvalidIndex = StringUtils::InvalidIndex;
     
     protected:
@@ -77,6 +83,7 @@ namespace Heart
 
         void Allocate(const T* str, u32 len);
         void AllocateMany(const T** strs, u32* lens, u32 count);
+        T* AllocateUninitialized(u32 len);
         HStringTyped<T> AddPtr(const T* other, bool prepend) const;
 
     protected:
@@ -220,6 +227,31 @@ namespace Heart
                 m_Container.Data()[dataIndex++] = strs[i][j];
     }
 
+    template <typename T>
+    T* HStringTyped<T>::AllocateUninitialized(u32 len)
+    {
+        // Resizing without constructing zeroes the buffer, which also places the terminator
+        m_Container.Clear(true);
+        m_Container.Resize(len + 1, false);
+        return m_Container.Data();
+    }
+
+    template <typename T>
+    template <typename U>
+    HStringTyped<T> HStringTyped<T>::Transcode(const U* str, u32 len)
+    {
+        static_assert(!std::is_same<T, U>::value, "Transcode must convert between different encodings");
+
+        HStringTyped<T> result;
+        if (!str || len == 0) return result;
+
+        if constexpr (std::is_same<T, char16>::value)
+            UTFUtils::ConvertUTF8ToUTF16(str, len, result.AllocateUninitialized(UTFUtils::GetUTF16Length(str, len)));
+        else
+            UTFUtils::ConvertUTF16ToUTF8(str, len, result.AllocateUninitialized(UTFUtils::GetUTF8Length(str, len)));
+        return result;
+    }
+
     template <typename T>
     HStringTyped<T> HStringTyped<T>::AddPtr(const T* other, bool prepend) const
     {
@@ -37,15 +37,24 @@ namespace Heart
 
         void Add(const T& elem)
         {
+            // Copy first in case elem lives inside of this vector and the add reallocates
+            if (Count() >= GetAllocatedCount())
+            {
+                T copy(elem);
+                u32 addIndex = m_Container.AddUninitialized();
+                HE_PLACEMENT_NEW(Begin() + addIndex, T, std::move(copy));
+                return;
+            }
+
             // Placement new here prevents accidental double destruction
-            u32 addIndex = PreAdd();
+            u32 addIndex = m_Container.AddUninitialized();
             HE_PLACEMENT_NEW(Begin() + addIndex, T, elem);
         }
 
         template <class... Args>
         void AddInPlace(Args... args)
         {
-            u32 addIndex = PreAdd();
+            u32 addIndex = m_Container.AddUninitialized();
             HE_PLACEMENT_NEW(
                 Begin() + addIndex,
                 T,
@@ -56,6 +65,7 @@ namespace Heart
         void Remove(u32 index)
         {
             if (index >= Count()) throw std::out_of_range("Called Remove() on container with out of range index");
+            m_Container.MakeUnique();
 
             // Destruct
             if constexpr (m_ShouldDestruct)
@@ -63,16 +73,17 @@ namespace Heart
 
             if (m_Container.DecrementCount() == 0 || index == Count()) return;
 
-            memmove(
+            RelocateElements(
                 Begin() + index,
                 Begin() + index + 1,
-                (Count() - index) * sizeof(T)
+                Count() - index
             );
         }
 
         void RemoveUnordered(u32 index)
         {
             if (index >= Count()) throw std::out_of_range("Called Remove() on container with out of range index");
+            m_Container.MakeUnique();
 
             // Destruct
             if constexpr (m_ShouldDestruct)
@@ -80,16 +91,17 @@ namespace Heart
 
             if (m_Container.DecrementCount() == 0) return;
             
-            memmove(
+            RelocateElements(
                 Begin() + index,
                 Begin() + Count(),
-                sizeof(T)
+                1
             );
         }
 
         void Pop()
         {
             if (Count() == 0) throw std::out_of_range("Called Pop() on container with a count of zero");
+            m_Container.MakeUnique();
 
             // Destruct
             if constexpr (m_ShouldDestruct)
@@ -111,10 +123,10 @@ namespace Heart
 
             Resize(oldCount + otherCount, false);
 
-            memmove(
+            RelocateElements(
                 Begin() + index + otherCount,
                 Begin() + index,
-                sizeof(T) * oldCount - index
+                oldCount - index
             );
             
             if (shallow)
@@ -128,20 +140,19 @@ namespace Heart
 
         void Insert(const T& other, u32 index)
         {
-            u32 oldCount = PreAdd();
+            // Copy first since other may live inside of this vector
+            T copy(other);
+            u32 oldCount = m_Container.AddUninitialized();
 
             // Shift elements
             index = std::min(index, oldCount);
-            if (index != oldCount)
-            {
-                memmove(
-                    Begin() + index + 1,
-                    Begin() + index,
-                    (oldCount - index) * sizeof(T)
-                );
-            }
+            RelocateElements(
+                Begin() + index + 1,
+                Begin() + index,
+                oldCount - index
+            );
 
-            HE_PLACEMENT_NEW(Begin() + index, T, other);
+            HE_PLACEMENT_NEW(Begin() + index, T, std::move(copy));
         }
 
         void Append(const HVector<T>& other, bool shallow = false)
@@ -157,7 +168,12 @@ namespace Heart
         inline void Resize(u32 elemCount, bool construct = true) { m_Container.Resize(elemCount, construct); }
         inline HVector Clone() const { return HVector(m_Container.Clone()); }
         inline HVector& CloneInPlace() { m_Container = Container(Data(), Count()); return *this; }
+        // Shares the buffer of from, which is safe across threads. Adding or removing elements on
+        // either side gives that vector its own copy, but writes through Data() or operator[] do
+        // not, so call MakeUnique first
         inline void ShallowCopy(const HVector& from) { m_Container.Copy(from.m_Container, true); }
+        inline void MakeUnique() { m_Container.MakeUnique(); }
+        inline bool IsShared() const { return m_Container.IsShared(); }
         inline u32 Count() const { return m_Container.Count(); }
         inline u32 GetAllocatedCount() const { return m_Container.GetAllocatedCount(); }
         inline u32 GetRefCount() const { return m_Container.GetRefCount(); }
@@ -177,23 +193,16 @@ namespace Heart
         inline T* end() const { return End(); }
 
     private:
-        HVector(const Container<T>& container)
-            : m_Container(container)
+        HVector(Container<T>&& container)
+            : m_Container(std::move(container))
         {}
 
-        u32 PreAdd()
-        {
-            u32 count = Count();
-            if (count >= m_Container.GetAllocatedCount())
-                m_Container.Resize(count + 1, false);
-            else
-                m_Container.IncrementCount();
-            return count;
-        }
-        
         inline static constexpr bool m_ShouldDestruct = std::is_destructible<T>::value && !std::is_trivially_destructible<T>::value;
 
     private:
         Container<T> m_Container;
     };
+
+    template <typename T>
+    struct IsTriviallyRelocatable<HVector<T>> : std::true_type {};
 }
@@ -6,6 +6,8 @@
 
 namespace Heart
 {
+    static_assert(sizeof(Variant) == 24, "Variant layout must match Variant.cs");
+
     Variant::Variant(bool value)
     { m_Type = Type::Bool; m_Data.Bool = (byte)value; }
     Variant::Variant(s8 value)
@@ -31,11 +33,31 @@ namespace Heart
     Variant::Variant(const HArray& array)
     { m_Type = Type::Array; HE_PLACEMENT_NEW(m_Data.Any, HArray, array); }
     Variant::Variant(const HStringView& str)
-    { m_Type = Type::String; HE_PLACEMENT_NEW(m_Data.Any, HString, str); }
+    {
+        m_Type = Type::String;
+        if (!TryInlineString(str))
+            HE_PLACEMENT_NEW(m_Data.Any, HString, str);
+    }
     Variant::Variant(const HString& str)
-    { m_Type = Type::String; HE_PLACEMENT_NEW(m_Data.Any, HString, str); }
+    {
+        m_Type = Type::String;
+        if (!TryInlineString(str))
+            HE_PLACEMENT_NEW(m_Data.Any, HString, str);
+    }
 
     Variant::~Variant()
+    {
+        Cleanup();
+    }
+
+    void Variant::operator=(const Variant& other)
+    {
+        if (&other == this) return;
+        Cleanup();
+        Copy(other);
+    }
+
+    void Variant::Cleanup()
     {
         switch (m_Type)
         {
@@ -48,7 +70,10 @@ namespace Heart
             case Type::Array:
             { reinterpret_cast<HArray*>(m_Data.Any)->~HArray(); } return;
             case Type::String:
-            { reinterpret_cast<HString*>(m_Data.Any)->~HString(); } return;
+            {
+                if (!m_InlineString)
+                    reinterpret_cast<HString*>(m_Data.Any)->~HString();
+            } return;
         }
 
         return;
@@ -57,12 +82,41 @@ namespace Heart
 
     HArray Variant::Array() const
     { return *reinterpret_cast<const HArray*>(m_Data.Any); }
+
     HString Variant::String() const
-    { return *reinterpret_cast<const HString*>(m_Data.Any); }
+    {
+        if (m_InlineString)
+            return HString(StringView());
+        return *reinterpret_cast<const HString*>(m_Data.Any);
+    }
+
+    HStringView Variant::StringView() const
+    {
+        if (!m_InlineString)
+            return *reinterpret_cast<const HString*>(m_Data.Any);
+        if ((HString::Encoding)m_InlineEncoding == HString::Encoding::UTF16)
+            return HStringView(reinterpret_cast<const char16*>(m_Data.Any), m_InlineCount);
+        return HStringView(reinterpret_cast<const char8*>(m_Data.Any), m_InlineCount);
+    }
+
+    bool Variant::TryInlineString(const HStringView& str)
+    {
+        u32 charSize = str.GetEncoding() == HString::Encoding::UTF16 ? sizeof(char16) : sizeof(char8);
+        u32 size = str.Count() * charSize;
+        if (size + charSize > sizeof(m_Data.Any)) return false;
+
+        m_InlineString = true;
+        m_InlineEncoding = (byte)str.GetEncoding();
+        m_InlineCount = (byte)str.Count();
+        memcpy(m_Data.Any, str.DataRaw(), size);
+        memset(m_Data.Any + size, 0, charSize);
+        return true;
+    }
 
     void Variant::Copy(const Variant& other)
     {
         m_Type = other.m_Type;
+        m_InlineString = other.m_InlineString;
         switch (m_Type)
         {
             case Type::None:
@@ -76,9 +130,19 @@ namespace Heart
             case Type::Float:
             { m_Data.Float = other.Float(); } return;
             case Type::Array:
-            { HE_PLACEMENT_NEW(m_Data.Any, HArray, other.Array()); } return;
+            { HE_PLACEMENT_NEW(m_Data.Any, HArray, *reinterpret_cast<const HArray*>(other.m_Data.Any)); } return;
             case Type::String:
-            { HE_PLACEMENT_NEW(m_Data.Any, HString, other.String()); } return;
+            {
+                if (!m_InlineString)
+                {
+                    HE_PLACEMENT_NEW(m_Data.Any, HString, *reinterpret_cast<const HString*>(other.m_Data.Any));
+                    return;
+                }
+
+                m_InlineEncoding = other.m_InlineEncoding;
+                m_InlineCount = other.m_InlineCount;
+                memcpy(m_Data.Any, other.m_Data.Any, sizeof(m_Data.Any));
+            } return;
         }
 
         HE_ENGINE_ASSERT(false, "Variant copy constructor not fully implemented");
@@ -100,7 +164,13 @@ namespace Heart
             case Variant::Type::Array:
             { j = variant.Array(); } return;
             case Variant::Type::String:
-            { j = variant.String(); } return;
+            {
+                HStringView str = variant.StringView();
+                if (str.GetEncoding() == HString::Encoding::UTF8)
+                    j = nlohmann::json::string_t(str.DataUTF8(), str.CountUTF8());
+                else
+                    j = str.ToUTF8().Data();
+            } return;
         }
     }
 
@@ -120,7 +190,7 @@ namespace Heart
             case nlohmann::json::value_t::array:
             { variant = Variant(j.get<HArray>()); } return;
             case nlohmann::json::value_t::string:
-            { variant = Variant(j.get<HString>()); } return;
+            { variant = Variant(HStringView(*j.get<const nlohmann::json::string_t*>())); } return;
         }
     }
 }
\ No newline at end of file
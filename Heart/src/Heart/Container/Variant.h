@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Heart/Container/Container.hpp"
 #include "nlohmann/json.hpp"
 
 namespace Heart
@@ -45,13 +46,28 @@ namespace Heart
         HArray Array() const;
         HString String() const;
 
-        inline void operator=(const Variant& other) { Copy(other); }
+        // Views the string without copying it. Only valid while the variant is alive and unchanged
+        HStringView StringView() const;
+
+        inline bool IsStringInline() const { return m_InlineString; }
+
+        void operator=(const Variant& other);
 
     private:
         void Copy(const Variant& other);
+        void Cleanup();
+        bool TryInlineString(const HStringView& str);
 
     private:
         Type m_Type = Type::None;
+
+        // Strings that fit in m_Data.Any along with their terminator are stored there directly
+        // so that creating, copying and destroying them never touches the heap. These fill what
+        // would otherwise be padding and are mirrored in Variant.cs
+        byte m_InlineString = false;
+        byte m_InlineEncoding = 0;
+        byte m_InlineCount = 0;
+
         union
         {
             byte Bool; // For safety and complete parity with c# b/c bool is technically not required to be one byte
@@ -62,6 +78,10 @@ namespace Heart
         } m_Data alignas(8); // See Variant.cs for details
     };
 
+    // Strings and arrays are stored inline as raw bytes, which all relocate trivially
+    template <>
+    struct IsTriviallyRelocatable<Variant> : std::true_type {};
+
     void to_json(nlohmann::json& j, const Variant& variant);
     void from_json(const nlohmann::json& j, Variant& variant);
 }
\ No newline at end of file
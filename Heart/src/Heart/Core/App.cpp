@@ -10,9 +10,11 @@
 #include "Heart/Events/WindowEvents.h"
 #include "Heart/Asset/AssetManager.h"
 #include "Heart/Renderer/Material.h"
+#include "Heart/Container/FrameArena.h"
 #include "Heart/Scripting/ScriptingEngine.h"
 #include "Heart/Task/TaskManager.h"
 #include "Heart/Task/JobManager.h"
+#include "Heart/Task/TaskTelemetry.h"
 #include "Heart/Util/PlatformUtils.h"
 #include "Heart/Util/FilesystemUtils.h"
 #include "Flourish/Api/Context.h"
@@ -33,10 +35,11 @@ namespace Heart
             HE_ENGINE_LOG_INFO("Running Heart in Release mode");
         #endif
         
-        u32 taskThreads = std::thread::hardware_concurrency() - 2;
-        HE_ENGINE_LOG_INFO("Using {0} task & job worker threads", taskThreads);
-        JobManager::Initialize(taskThreads);
-        TaskManager::Initialize(taskThreads);
+        // Tasks and jobs share one pool with a pinned worker for every hardware thread besides the
+        // main thread, which helps out whenever it waits
+        TaskManager::Initialize(TaskManager::WorkerPolicy::LogicalCores);
+        JobManager::Initialize();
+        HE_ENGINE_LOG_INFO("Using {0} worker threads", TaskManager::GetWorkerCount());
 
         // Run on main thread, since some platforms have issues otherwise
         if (!ScriptingEngine::Initialize())
@@ -63,6 +66,9 @@ namespace Heart
         InitializeGraphicsApi();
         HE_ENGINE_LOG_DEBUG("Graphics ready");
 
+        // Transient per frame data must outlive every frame the GPU may still be working on
+        FrameArena::Initialize(Flourish::Context::FrameBufferCount());
+
         // Init services
         TaskGroup initServices;
         initServices.AddTask(TaskManager::Schedule(
@@ -93,6 +99,7 @@ namespace Heart
             layer->OnDetach();
 
         ShutdownGraphicsApi();
+        FrameArena::Shutdown();
         
         PlatformUtils::ShutdownPlatform();
 
@@ -221,6 +228,8 @@ namespace Heart
 
     void App::Run()
     {
+        TaskTelemetry::RegisterThread("Main Thread", false);
+
         while (m_Running)
         {
             HE_PROFILE_FRAME();
@@ -235,7 +244,8 @@ namespace Heart
             m_AveragedTimestep = averaged / m_TimestepSamples.size();
             m_LastFrameTime = currentFrameTime;
 
-            auto timer = AggregateTimer("App::Run - PollEvents");
+            static const HStringId pollEventsTimerId = "App::Run - PollEvents";
+            auto timer = AggregateTimer(pollEventsTimerId);
             if (m_Window->PollEvents())
             {
                 // True here means the window was internally recreated, so we need to update objects
@@ -248,20 +258,31 @@ namespace Heart
             if (!m_Minimized && m_Window->GetRenderContext()->Validate())
             {
                 // Begin frame
-                timer = AggregateTimer("App::Run - Begin frame");
+                static const HStringId beginFrameTimerId = "App::Run - Begin frame";
+                timer = AggregateTimer(beginFrameTimerId);
+                AssetManager::ProcessFileEvents();
                 AssetManager::UnloadOldAssets();
                 Flourish::Context::BeginFrame();
+                FrameArena::BeginFrame();
                 m_ImGuiInstance->BeginFrame();
                 timer.Finish();
 
                 // Layer update
-                timer = AggregateTimer("App::Run - Layer update");
+                static const HStringId layerUpdateTimerId = "App::Run - Layer update";
+                timer = AggregateTimer(layerUpdateTimerId);
                 for (auto layer : m_Layers)
                     layer->OnUpdate(m_LastTimestep);
                 timer.Finish();
 
+                // Work handed off to the main thread (i.e. from asset loads)
+                static const HStringId mainThreadTasksTimerId = "App::Run - Main thread tasks";
+                timer = AggregateTimer(mainThreadTasksTimerId);
+                TaskManager::ProcessMainThreadQueue(m_MainThreadTaskBudget);
+                timer.Finish();
+
                 // End frame
-                timer = AggregateTimer("App::Run - End frame");
+                static const HStringId endFrameTimerId = "App::Run - End frame";
+                timer = AggregateTimer(endFrameTimerId);
                 m_ImGuiInstance->EndFrame();
                 m_Window->EndFrame();
                 Input::EndFrame();
@@ -273,6 +294,7 @@ namespace Heart
             }
 
             AggregateTimer::EndFrame();
+            TaskTelemetry::MarkFrame();
         }
     }
 }
@@ -86,6 +86,19 @@ namespace Heart
         /*! @brief Get the average timestamp from the last 5 frames */
         inline Timestep GetAveragedTimestep() const { return m_AveragedTimestep; }
 
+        /**
+         * @brief Set how long each frame may spend running tasks scheduled with
+         *        TaskManager::ScheduleMainThread.
+         *
+         * At least one queued task always runs per frame regardless of the budget.
+         *
+         * @param budget The budget in milliseconds.
+         */
+        inline void SetMainThreadTaskBudget(double budget) { m_MainThreadTaskBudget = budget; }
+
+        /*! @brief Get the per frame main thread task budget in milliseconds. */
+        inline double GetMainThreadTaskBudget() const { return m_MainThreadTaskBudget; }
+
     protected:
         HVector<Ref<Layer>> m_Layers;
         Ref<ImGuiInstance> m_ImGuiInstance;
@@ -97,6 +110,7 @@ namespace Heart
         std::array<double, 5> m_TimestepSamples;
         Timestep m_AveragedTimestep;
         Timestep m_LastTimestep;
+        double m_MainThreadTaskBudget = 2.0;
 
     private:
         void InitializeGraphicsApi();
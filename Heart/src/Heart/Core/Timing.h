@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Heart/Container/HString8.h"
+#include "Heart/Container/HStringId.h"
 #include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HFlatMap.hpp"
 
 namespace Heart
 {
@@ -77,10 +79,13 @@ namespace Heart
         /**
          * @brief Default constructor.
          *
+         * Timers usually run every frame, so the id should be created once up front (i.e. as a
+         * function local static) rather than from a string literal on every call.
+         *
          * @param name The name/id associated with this timer.
          */
-        AggregateTimer(const HString8& name)
-            : Timer(name, false)
+        AggregateTimer(HStringId name)
+            : Timer(HString8(), false), m_Id(name)
         {}
 
         /*! @brief Default destructor. */
@@ -101,7 +106,7 @@ namespace Heart
                 return;
 
             std::unique_lock lock(s_CurrentMutex);
-            auto& samples = s_AggregateTimes[m_Name];
+            auto& samples = s_AggregateTimes[m_Id];
             samples.Insert(ms, 0);
         }
         
@@ -114,20 +119,17 @@ namespace Heart
          * @param name The name/id of the timer.
          * @return The time in milliseconds or zero if the id is invalid.
          */
-        static double GetAggregateTime(const HString8& name)
+        static double GetAggregateTime(HStringId name)
         {
             std::shared_lock lock(s_CurrentMutex);
-            if (s_AggregateTimes.find(name) == s_AggregateTimes.end()) return 0;
+            const auto* samples = s_AggregateTimes.Find(name);
+            if (!samples || samples->IsEmpty()) return 0;
             
             double average = 0.0;
-            const auto& samples = s_AggregateTimes[name];
-            if (samples.IsEmpty())
-                return average;
-
-            for (double val : samples)
+            for (double val : *samples)
                 average += val;
 
-            return average / samples.Count();
+            return average / samples->Count();
         }
 
         /**
@@ -135,11 +137,11 @@ namespace Heart
          *
          * @param name The name/id of the timer.
          */
-        static void ResetAggregateTime(const HString8& name)
+        static void ResetAggregateTime(HStringId name)
         {
             std::unique_lock lock(s_CurrentMutex);
-            if (s_AggregateTimes.find(name) != s_AggregateTimes.end())
-                s_AggregateTimes[name].Clear();
+            if (auto* samples = s_AggregateTimes.Find(name))
+                samples->Clear();
         }
 
         /*! @brief Store the current aggregate times for retrieval and prepare for next frame. */
@@ -152,16 +154,18 @@ namespace Heart
         }
 
         /*! @brief Get the map containing all timer ids and aggregate times from the last frame. */
-        inline static const std::map<HString8, HVector<double>>& GetTimeMap() { return s_AggregateTimes; }
+        inline static const HFlatMap<HStringId, HVector<double>>& GetTimeMap() { return s_AggregateTimes; }
 
         /*! @brief Clear all current stored timer ids and aggregate times. */
-        inline static void ClearTimeMap() { std::unique_lock lock(s_CurrentMutex); s_AggregateTimes.clear(); }
+        inline static void ClearTimeMap() { std::unique_lock lock(s_CurrentMutex); s_AggregateTimes.Clear(); }
 
     private:
-        inline static std::map<HString8, HVector<double>> s_AggregateTimes; // stored in millis
+        // Keyed by id so that recording a sample only hashes and compares integers
+        inline static HFlatMap<HStringId, HVector<double>> s_AggregateTimes; // stored in millis
         inline static std::shared_mutex s_CurrentMutex;
         
     private:
+        HStringId m_Id;
         bool m_Finished = false;
     };
 }
@@ -62,7 +62,7 @@ namespace Heart
         envMapCreateInfo.FrameDataPluginName = frameData->GetName();
         auto envMap = RegisterPlugin<RenderPlugins::RenderEnvironmentMap>("EnvMap", envMapCreateInfo);
 
-        HString8 pbrCompositeName;
+        HStringId pbrCompositeName;
         if (rayTracing)
         {
             RenderPlugins::TLASCreateInfo tlasCreateInfo;
@@ -11,8 +11,8 @@
 
 namespace Heart
 {
-    Mesh::Mesh(const HVector<Vertex>& vertices, const HVector<u32>& indices, u32 materialIndex)
-        : m_Vertices(vertices), m_Indices(indices), m_MaterialIndex(materialIndex)
+    Mesh::Mesh(HFrozenVector<Vertex> vertices, HFrozenVector<u32> indices, u32 materialIndex)
+        : m_Vertices(std::move(vertices)), m_Indices(std::move(indices)), m_MaterialIndex(materialIndex)
     {
         Ref<Flourish::CommandBuffer> uploadBuf = Flourish::CommandBuffer::Create({ false });
 
@@ -21,9 +21,9 @@ namespace Heart
         bufCreateInfo.MemoryType = Flourish::BufferMemoryType::GPUOnly;
         bufCreateInfo.Usage = Flourish::BufferUsageFlags::Vertex;
         bufCreateInfo.Layout = s_VertexLayout;
-        bufCreateInfo.ElementCount = vertices.Count();
-        bufCreateInfo.InitialData = vertices.Data();
-        bufCreateInfo.InitialDataSize = sizeof(Vertex) * vertices.Count();
+        bufCreateInfo.ElementCount = m_Vertices.Count();
+        bufCreateInfo.InitialData = m_Vertices.Data();
+        bufCreateInfo.InitialDataSize = sizeof(Vertex) * m_Vertices.Count();
         bufCreateInfo.UploadEncoder = uploadEncoder;
         if (Flourish::Context::FeatureTable().RayTracing)
         {
@@ -34,9 +34,9 @@ namespace Heart
 
         bufCreateInfo.Usage = Flourish::BufferUsageFlags::Index;
         bufCreateInfo.Layout = s_IndexLayout;
-        bufCreateInfo.ElementCount = indices.Count();
-        bufCreateInfo.InitialData = indices.Data();
-        bufCreateInfo.InitialDataSize = sizeof(u32) * indices.Count();
+        bufCreateInfo.ElementCount = m_Indices.Count();
+        bufCreateInfo.InitialData = m_Indices.Data();
+        bufCreateInfo.InitialDataSize = sizeof(u32) * m_Indices.Count();
         if (Flourish::Context::FeatureTable().RayTracing)
         {
             bufCreateInfo.Usage |= Flourish::BufferUsageFlags::AccelerationStructureBuild;
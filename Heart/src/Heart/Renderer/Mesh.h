@@ -3,7 +3,7 @@
 #include "glm/vec4.hpp"
 #include "glm/vec3.hpp"
 #include "glm/vec2.hpp"
-#include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HFrozenVector.hpp"
 #include "Flourish/Api/Buffer.h"
 
 namespace Flourish
@@ -31,10 +31,11 @@ namespace Heart
         };
 
     public:
-        Mesh(const HVector<Vertex>& vertices, const HVector<u32>& indices, u32 materialIndex);
+        // Copies of a mesh share its vertex and index data
+        Mesh(HFrozenVector<Vertex> vertices, HFrozenVector<u32> indices, u32 materialIndex);
         Mesh() = default;
 
-        const HVector<Vertex>& GetVertices() const { return m_Vertices; }
+        const HFrozenVector<Vertex>& GetVertices() const { return m_Vertices; }
         const Flourish::Buffer* GetVertexBuffer() const { return m_VertexBuffer.get(); }
         const Flourish::Buffer* GetIndexBuffer() const { return m_IndexBuffer.get(); }
         const Flourish::AccelerationStructure* GetAccelStructure() const { return m_AccelStructure.get(); }
@@ -62,8 +63,8 @@ namespace Heart
 
     private:
         u32 m_BufferReadyCount = 0;
-        HVector<Vertex> m_Vertices;
-        HVector<u32> m_Indices;
+        HFrozenVector<Vertex> m_Vertices;
+        HFrozenVector<u32> m_Indices;
         u32 m_MaterialIndex;
         Ref<Flourish::Buffer> m_VertexBuffer;
         Ref<Flourish::Buffer> m_IndexBuffer;
@@ -32,7 +32,8 @@ namespace Heart::RenderPlugins
     void BlitTexture::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::BlitTexture");
+        static const HStringId timerId = "RenderPlugins::BlitTexture";
+        auto timer = AggregateTimer(timerId);
 
         u32 srcLayerIndex = m_Info.SrcDynamicLayerIndex
             ? Flourish::Context::FrameCount() % m_Info.SrcLayerIndex
@@ -89,7 +89,8 @@ namespace Heart::RenderPlugins
     void Bloom::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::Bloom");
+        static const HStringId timerId = "RenderPlugins::Bloom";
+        auto timer = AggregateTimer(timerId);
 
         m_Stats["GPU Time (Downsample)"].Type = StatType::TimeMS;
         m_Stats["GPU Time (Downsample)"].Data.Float = (float)(m_CommandBuffer->ComputeTimestampDifference(0, 1) * 1e-6);
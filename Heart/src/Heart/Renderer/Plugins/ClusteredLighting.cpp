@@ -82,7 +82,8 @@ namespace Heart::RenderPlugins
     void ClusteredLighting::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::ClusteredLighting");
+        static const HStringId timerId = "RenderPlugins::ClusteredLighting";
+        auto timer = AggregateTimer(timerId);
 
         // Update scale and bias based on camera info
         ClusterData clusterData;
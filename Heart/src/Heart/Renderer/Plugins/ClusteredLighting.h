@@ -14,8 +14,8 @@ namespace Heart::RenderPlugins
 {
     struct ClusteredLightingCreateInfo
     {
-        HString8 FrameDataPluginName;
-        HString8 LightingDataPluginName;
+        HStringId FrameDataPluginName;
+        HStringId LightingDataPluginName;
     };
 
     class ClusteredLighting : public RenderPlugin
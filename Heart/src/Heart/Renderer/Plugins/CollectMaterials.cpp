@@ -55,9 +55,8 @@ namespace Heart::RenderPlugins
         // TODO: probably should use UUIDs in the map, but that won't work
         // right now because default materials don't have ids
         u64 matId = (u64)material;
-        if (m_MaterialMap.find(matId) != m_MaterialMap.end())
+        if (!m_MaterialMap.Insert(matId, m_MaterialIndex))
             return;
-        m_MaterialMap.insert({ matId, m_MaterialIndex });
 
         MaterialInfo matInfo;
         matInfo.Data = material->GetMaterialData();
@@ -72,9 +71,10 @@ namespace Heart::RenderPlugins
     void CollectMaterials::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::CollectMaterials");
+        static const HStringId timerId = "RenderPlugins::CollectMaterials";
+        auto timer = AggregateTimer(timerId);
 
-        m_MaterialMap.clear();
+        m_MaterialMap.Clear();
         m_MaterialIndex = 0;
         m_TextureIndex = 0;
 
@@ -84,7 +84,7 @@ namespace Heart::RenderPlugins
             defMat->EnsureValid();
             MaterialInfo matInfo = { defMat->GetMaterial().GetMaterialData() };
             m_MaterialBuffer->SetElements(&matInfo, 1, 0);
-            m_MaterialMap.insert({ 0, 0 });
+            m_MaterialMap.Insert(0, 0);
             m_MaterialIndex++;
         }
 
@@ -2,6 +2,7 @@
 
 #include "Heart/Renderer/RenderPlugin.h"
 #include "Heart/Renderer/Material.h"
+#include "Heart/Container/HFlatMap.hpp"
 #include "Flourish/Api/ResourceSet.h"
 
 namespace Flourish
@@ -56,7 +57,7 @@ namespace Heart::RenderPlugins
 
         Ref<Flourish::ResourceSet> m_TexturesSet;
         Ref<Flourish::Buffer> m_MaterialBuffer;
-        std::unordered_map<u64, u32> m_MaterialMap;
+        HFlatMap<u64, u32> m_MaterialMap;
 
         u32 m_MaxMaterials = 5000;
         u32 m_MaxTextures = 1000;
@@ -46,7 +46,8 @@ namespace Heart::RenderPlugins
     void ColorGrading::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::ColorGrading");
+        static const HStringId timerId = "RenderPlugins::ColorGrading";
+        auto timer = AggregateTimer(timerId);
 
         m_Stats["GPU Time"].Type = StatType::TimeMS;
         m_Stats["GPU Time"].Data.Float = (float)(m_CommandBuffer->ComputeTimestampDifference(0, 1) * 1e-6);
@@ -8,6 +8,7 @@
 #include "Heart/Asset/MaterialAsset.h"
 #include "Heart/Core/Timing.h"
 #include "Heart/Core/App.h"
+#include "Heart/Task/JobManager.h"
 
 namespace Heart::RenderPlugins
 {
@@ -30,7 +31,8 @@ namespace Heart::RenderPlugins
     void ComputeMeshBatches::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::ComputeMeshBatches");
+        static const HStringId timerId = "RenderPlugins::ComputeMeshBatches";
+        auto timer = AggregateTimer(timerId);
 
         auto materialsPlugin = m_Renderer->GetPlugin<RenderPlugins::CollectMaterials>(m_Info.CollectMaterialsPluginName);
         const auto& materialMap = materialsPlugin->GetMaterialMap();
@@ -39,7 +41,7 @@ namespace Heart::RenderPlugins
         auto& batchData = m_BatchData;
 
         // Clear previous data
-        batchData.Batches.clear();
+        batchData.Batches.Clear();
         batchData.TotalInstanceCount = 0;
         for (auto& list : batchData.EntityListPool)
             list.Clear();
@@ -52,7 +54,7 @@ namespace Heart::RenderPlugins
         for (entt::entity entity : meshView)
         {
             const auto& meshComp = meshView.get<MeshComponent>(entity);
-            const auto& transformData = data.Scene->GetCachedTransforms().at(entity);
+            const auto& transformData = data.Scene->GetCachedTransforms().Get(entity);
 
             // Compute max scale for calculating the bounding sphere
             // TODO: scale scale by some factor or some sort of predictive culling based on camera speed
@@ -108,45 +110,55 @@ namespace Heart::RenderPlugins
                 }
                 bool usePrepass = selectedMaterial->GetTransparencyMode() != TransparencyMode::AlphaBlend;
 
-                u64 materialId = (u64)selectedMaterial;
-                if (materialMap.find(materialId) == materialMap.end())
-                    materialId = 0; // Default material
+                u32* foundMaterial = materialMap.Find((u64)selectedMaterial);
+                u32 materialIndex = foundMaterial ? *foundMaterial : 0; // Default material
 
                 if (usePrepass)
-                {
                     batch.Count++;
-                    batchData.TotalInstanceCount++;
-                }
 
                 // Push the associated entity to the associated vector from the pool
                 batchData.EntityListPool[batch.EntityListIndex].AddInPlace(EntityListEntry {
                     (u32)entity,
-                    materialMap.at(materialId),
+                    materialIndex,
                     usePrepass
                 });
             }
         }
 
-        // Loop over the calculated batches and populate the indirect buffer with draw commands. Because we are instancing, we need to make sure each object data
-        // element gets placed contiguously for each indirect draw call. At this stage, Batch.First is the index of the indirect draw command in the buffer and
-        // Batch.Count will equal 1 because it represents how many draw commands are in each batch
-        u32 commandIndex = 0;
-        u32 objectId = 0;
+        // Give every batch the index of its first object with a prefix sum over the instance counts so
+        // that the batches can be filled in independently of each other
+        m_BatchList.Clear();
         for (auto& pair : batchData.Batches)
+            m_BatchList.Add(&pair.Value);
+        m_ObjectOffsets.Resize(m_BatchList.Count(), false);
+        batchData.TotalInstanceCount = JobManager::ParallelExclusiveScan(
+            m_BatchList.Count(), 64, 0u,
+            [this](size_t i) { return m_BatchList[i]->Count; },
+            [this](size_t i, u32 offset) { m_ObjectOffsets[i] = offset; }
+        );
+
+        // Populate the draw commands and object data. Because we are instancing, we need to make sure each object data
+        // element gets placed contiguously for each indirect draw call. At this stage, Batch.First is the index of the indirect
+        // draw command in the buffer and Batch.Count will equal 1 because it represents how many draw commands are in each batch
+        m_Commands.Resize(m_BatchList.Count(), false);
+        m_Objects.Resize(batchData.TotalInstanceCount, false);
+        JobManager::ParallelFor(0, m_BatchList.Count(), 4, [this, &data](size_t batchIndex)
         {
+            auto& batch = *m_BatchList[batchIndex];
+            u32 objectId = m_ObjectOffsets[batchIndex];
+
             // Update the draw command index
-            pair.second.First = commandIndex;
+            batch.First = batchIndex;
 
-            // Popupate the indirect buffer
-            IndexedIndirectCommand command = {
-                pair.second.Mesh->GetIndexBuffer()->GetAllocatedCount(),
-                pair.second.Count,
+            // Populate the draw command
+            m_Commands[batchIndex] = {
+                batch.Mesh->GetIndexBuffer()->GetAllocatedCount(),
+                batch.Count,
                 0, 0, objectId
             };
-            batchData.IndirectBuffer->SetElements(&command, 1, commandIndex);
 
             // Sort the batch by material to help with cache coherency
-            auto& entityList = batchData.EntityListPool[pair.second.EntityListIndex];
+            auto& entityList = m_BatchData.EntityListPool[batch.EntityListIndex];
             std::sort(
                 entityList.begin(),
                 entityList.end(),
@@ -158,25 +170,28 @@ namespace Heart::RenderPlugins
             {
                 if (!entity.IncludeInPrepass) continue;
 
-                const auto& transformData = data.Scene->GetCachedTransforms().at((entt::entity)entity.EntityId);
+                const auto& transformData = data.Scene->GetCachedTransforms().Get((entt::entity)entity.EntityId);
 
                 // Object data
-                ObjectData objectData = {
+                m_Objects[objectId] = {
                     transformData.Transform,
                     entity.MaterialIndex,
                     entity.EntityId
                 };
-                batchData.ObjectDataBuffer->SetElements(&objectData, 1, objectId);
 
                 objectId++;
             }
 
             // Change the count to represent the number of draw commands
             // Only relevant when using GPU culling
-            pair.second.Count = 1;
-
-            commandIndex++;
-        }
+            batch.Count = 1;
+        }).Wait();
+
+        // Upload everything at once now that the layout is known
+        if (!m_Commands.IsEmpty())
+            batchData.IndirectBuffer->SetElements(m_Commands.Data(), m_Commands.Count(), 0);
+        if (!m_Objects.IsEmpty())
+            batchData.ObjectDataBuffer->SetElements(m_Objects.Data(), m_Objects.Count(), 0);
         
         m_Stats["Instance Count"] = {
             StatType::Int,
@@ -184,7 +199,7 @@ namespace Heart::RenderPlugins
         };
         m_Stats["Batch Count"] = {
             StatType::Int,
-            (int)batchData.Batches.size()
+            (int)batchData.Batches.Count()
         };
     }
 
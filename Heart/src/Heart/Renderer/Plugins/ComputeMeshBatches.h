@@ -3,6 +3,7 @@
 #include "glm/mat4x4.hpp"
 #include "Flourish/Api/Context.h"
 #include "Heart/Renderer/RenderPlugin.h"
+#include "Heart/Container/FrameArena.h"
 
 namespace Flourish
 {
@@ -19,7 +20,7 @@ namespace Heart::RenderPlugins
 {
     struct ComputeMeshBatchesCreateInfo
     {
-        HString8 CollectMaterialsPluginName;
+        HStringId CollectMaterialsPluginName;
     };
 
     class ComputeMeshBatches : public RenderPlugin
@@ -63,7 +64,7 @@ namespace Heart::RenderPlugins
 
         struct BatchData
         {
-            std::unordered_map<u64, MeshBatch> Batches;
+            FrameHashMap<u64, MeshBatch> Batches;
             HVector<HVector<EntityListEntry>> EntityListPool;
 
             Ref<Flourish::Buffer> IndirectBuffer;
@@ -93,5 +94,11 @@ namespace Heart::RenderPlugins
 
         BatchData m_BatchData;
         u32 m_MaxObjects = 10000; // TODO: parameterize
+
+        // Scratch space reused across frames
+        HVector<MeshBatch*> m_BatchList;
+        HVector<u32> m_ObjectOffsets;
+        HVector<IndexedIndirectCommand> m_Commands;
+        HVector<ObjectData> m_Objects;
     };
 }
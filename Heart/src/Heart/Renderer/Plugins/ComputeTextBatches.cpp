@@ -33,7 +33,8 @@ namespace Heart::RenderPlugins
     void ComputeTextBatches::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::ComputeTextBatches");
+        static const HStringId timerId = "RenderPlugins::ComputeTextBatches";
+        auto timer = AggregateTimer(timerId);
 
         auto materialsPlugin = m_Renderer->GetPlugin<RenderPlugins::CollectMaterials>(m_Info.CollectMaterialsPluginName);
         const auto& materialMap = materialsPlugin->GetMaterialMap();
@@ -56,7 +57,7 @@ namespace Heart::RenderPlugins
             if (!textComp.ComputedMesh.GetVertexBuffer())
                 continue;
 
-            const auto& transformData = data.Scene->GetCachedTransforms().at(entity);
+            const auto& transformData = data.Scene->GetCachedTransforms().Get(entity);
 
             auto fontAsset = AssetManager::RetrieveAsset<FontAsset>(textComp.Font);
             if (!fontAsset || !fontAsset->Load(!async)->IsValid())
@@ -67,9 +68,8 @@ namespace Heart::RenderPlugins
             if (materialAsset && materialAsset->Load(!async)->IsValid())
                 selectedMaterial = &materialAsset->GetMaterial();
 
-            u64 materialId = (u64)selectedMaterial;
-            if (materialMap.find(materialId) == materialMap.end())
-                materialId = 0; // Default material
+            u32* foundMaterial = materialMap.Find((u64)selectedMaterial);
+            u32 materialIndex = foundMaterial ? *foundMaterial : 0; // Default material
 
             // Here we assume each text component has a different mesh. This is likely the case, so
             // add a new batch each time
@@ -99,7 +99,7 @@ namespace Heart::RenderPlugins
             // Object data
             ComputeMeshBatches::ObjectData objectData = {
                 transformData.Transform,
-                materialMap.at(materialId),
+                materialIndex,
                 (u32)entity
             };
             newComputedData.ObjectDataBuffer->SetElements(&objectData, 1, objectId);
@@ -16,7 +16,7 @@ namespace Heart::RenderPlugins
 {
     struct ComputeTextBatchesCreateInfo
     {
-        HString8 CollectMaterialsPluginName;
+        HStringId CollectMaterialsPluginName;
     };
 
     class ComputeTextBatches : public RenderPlugin
@@ -149,7 +149,8 @@ namespace Heart::RenderPlugins
     void Forward::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::Forward");
+        static const HStringId timerId = "RenderPlugins::Forward";
+        auto timer = AggregateTimer(timerId);
 
         // Update timing stats
         m_Stats["GPU Time (Objects)"].Type = StatType::TimeMS;
@@ -218,9 +219,9 @@ namespace Heart::RenderPlugins
         encoder->FlushResourceSet(0);
         encoder->BindResourceSet(materialsPlugin->GetTexturesSet(), 1);
         encoder->FlushResourceSet(1);
-        for (auto& pair : meshBatchData.Batches)
+        for (auto& entry : meshBatchData.Batches)
         {
-            auto& batch = pair.second;
+            auto& batch = entry.Value;
             
             // Draw
             encoder->BindVertexBuffer(batch.Mesh->GetVertexBuffer());
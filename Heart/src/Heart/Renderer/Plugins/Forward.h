@@ -16,10 +16,10 @@ namespace Heart::RenderPlugins
     {
         Ref<Flourish::Texture> OutputTexture;
         Ref<Flourish::Texture> DepthTexture;
-        HString8 MeshBatchesPluginName;
-        HString8 TextBatchesPluginName;
-        HString8 CollectMaterialsPluginName;
-        HString8 FrameDataPluginName;
+        HStringId MeshBatchesPluginName;
+        HStringId TextBatchesPluginName;
+        HStringId CollectMaterialsPluginName;
+        HStringId FrameDataPluginName;
     };
 
     class Forward : public RenderPlugin
@@ -207,7 +207,8 @@ namespace Heart::RenderPlugins
     void GBuffer::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::GBuffer");
+        static const HStringId timerId = "RenderPlugins::GBuffer";
+        auto timer = AggregateTimer(timerId);
 
         // Update timing stats
         m_Stats["GPU Time (Objects)"].Type = StatType::TimeMS;
@@ -240,9 +241,9 @@ namespace Heart::RenderPlugins
         encoder->FlushResourceSet(1);
         encoder->ClearDepthAttachment();
         encoder->PushConstants(0, sizeof(PushData), &m_PushData);
-        for (auto& pair : meshBatchData.Batches)
+        for (auto& entry : meshBatchData.Batches)
         {
-            auto& batch = pair.second;
+            auto& batch = entry.Value;
             
             // Draw
             encoder->BindVertexBuffer(batch.Mesh->GetVertexBuffer());
@@ -18,11 +18,11 @@ namespace Heart::RenderPlugins
         u32 MipCount;
         bool StoreMotionVectors;
         bool StoreColorAndEmissiveData;
-        HString8 MeshBatchesPluginName;
-        HString8 TextBatchesPluginName;
-        HString8 CollectMaterialsPluginName;
-        HString8 FrameDataPluginName;
-        HString8 EntityIdsPluginName; // Optional
+        HStringId MeshBatchesPluginName;
+        HStringId TextBatchesPluginName;
+        HStringId CollectMaterialsPluginName;
+        HStringId FrameDataPluginName;
+        HStringId EntityIdsPluginName; // Optional
     };
 
     class GBuffer : public RenderPlugin
@@ -86,7 +86,8 @@ namespace Heart::RenderPlugins
     void InfiniteGrid::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::InfiniteGrid");
+        static const HStringId timerId = "RenderPlugins::InfiniteGrid";
+        auto timer = AggregateTimer(timerId);
 
         m_Stats["GPU Time"].Type = StatType::TimeMS;
         m_Stats["GPU Time"].Data.Float = (float)(m_CommandBuffer->ComputeTimestampDifference(0, 1) * 1e-6);
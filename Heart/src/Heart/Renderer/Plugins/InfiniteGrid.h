@@ -17,7 +17,7 @@ namespace Heart::RenderPlugins
         Ref<Flourish::Texture> OutputDepthTexture;
         bool ClearColorOutput;
         bool ClearDepthOutput;
-        HString8 FrameDataPluginName;
+        HStringId FrameDataPluginName;
     };
 
     class InfiniteGrid : public RenderPlugin
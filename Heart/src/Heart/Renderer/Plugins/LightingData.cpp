@@ -94,11 +94,16 @@ namespace Heart::RenderPlugins
     void LightingData::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::LightingData");
+        static const HStringId timerId = "RenderPlugins::LightingData";
+        auto timer = AggregateTimer(timerId);
 
         m_Instances.Clear();
         m_Transforms.Clear();
 
+        // Instances point into the transform list, so it must never reallocate while being filled
+        if (m_UseRayTracing)
+            m_Transforms.Reserve(m_MaxLights);
+
         Flourish::AccelerationStructureInstance instance;
         instance.Parent = m_LightBLAS.get();
 
@@ -111,7 +116,7 @@ namespace Heart::RenderPlugins
                 break;
 
             const auto& lightComp = lightView.get<LightComponent>(entity);
-            const auto& transformData = data.Scene->GetCachedTransforms().at(entity);
+            const auto& transformData = data.Scene->GetCachedTransforms().Get(entity);
 
             u32 offset = lightIndex * m_Buffer->GetStride();
 
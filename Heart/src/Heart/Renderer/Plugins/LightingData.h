@@ -2,6 +2,7 @@
 
 #include "glm/mat4x4.hpp"
 #include "Heart/Renderer/RenderPlugin.h"
+#include "Heart/Container/FrameArena.h"
 #include "Flourish/Api/RayTracing/AccelerationStructure.h"
 
 namespace Flourish
@@ -44,8 +45,9 @@ namespace Heart::RenderPlugins
         Ref<Flourish::AccelerationStructure> m_LightTLAS;
         Ref<Flourish::AccelerationStructure> m_LightBLAS;
 
-        HVector<Flourish::AccelerationStructureInstance> m_Instances;
-        HVector<glm::mat4> m_Transforms;
+        // Read by the TLAS build after this plugin returns, so they live in the frame arena
+        FrameVector<Flourish::AccelerationStructureInstance> m_Instances;
+        FrameVector<glm::mat4> m_Transforms;
 
         u32 m_MaxLights = 750;
         u32 m_MaxDirectionalLights = 64;
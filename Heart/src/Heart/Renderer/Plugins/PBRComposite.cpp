@@ -63,7 +63,8 @@ namespace Heart::RenderPlugins
     void PBRComposite::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::PBRComposite");
+        static const HStringId timerId = "RenderPlugins::PBRComposite";
+        auto timer = AggregateTimer(timerId);
 
         m_Stats["GPU Time"].Type = StatType::TimeMS;
         m_Stats["GPU Time"].Data.Float = (float)(m_CommandBuffer->ComputeTimestampDifference(0, 1) * 1e-6);
@@ -14,11 +14,11 @@ namespace Heart::RenderPlugins
     struct PBRCompositeCreateInfo
     {
         Ref<Flourish::Texture> OutputTexture;
-        HString8 FrameDataPluginName;
-        HString8 LightingDataPluginName;
-        HString8 GBufferPluginName;
-        HString8 SSAOPluginName;
-        HString8 ClusteredLightingPluginName;
+        HStringId FrameDataPluginName;
+        HStringId LightingDataPluginName;
+        HStringId GBufferPluginName;
+        HStringId SSAOPluginName;
+        HStringId ClusteredLightingPluginName;
     };
 
     class PBRComposite : public RenderPlugin
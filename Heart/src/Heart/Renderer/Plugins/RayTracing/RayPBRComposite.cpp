@@ -106,7 +106,8 @@ namespace Heart::RenderPlugins
     void RayPBRComposite::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::RayPBRComposite");
+        static const HStringId timerId = "RenderPlugins::RayPBRComposite";
+        auto timer = AggregateTimer(timerId);
 
         auto frameDataPlugin = m_Renderer->GetPlugin<RenderPlugins::FrameData>(m_Info.FrameDataPluginName);
         auto frameDataBuffer = frameDataPlugin->GetBuffer();
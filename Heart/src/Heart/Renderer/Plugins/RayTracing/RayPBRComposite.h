@@ -16,13 +16,13 @@ namespace Heart::RenderPlugins
     {
         Ref<Flourish::Texture> ReflectionsInputTexture;
         Ref<Flourish::Texture> OutputTexture;
-        HString8 FrameDataPluginName;
-        HString8 LightingDataPluginName;
-        HString8 GBufferPluginName;
-        HString8 SSAOPluginName;
-        HString8 ClusteredLightingPluginName;
-        HString8 TLASPluginName;
-        HString8 CollectMaterialsPluginName;
+        HStringId FrameDataPluginName;
+        HStringId LightingDataPluginName;
+        HStringId GBufferPluginName;
+        HStringId SSAOPluginName;
+        HStringId ClusteredLightingPluginName;
+        HStringId TLASPluginName;
+        HStringId CollectMaterialsPluginName;
     };
 
     class RayPBRComposite : public RenderPlugin
@@ -129,7 +129,8 @@ namespace Heart::RenderPlugins
     void RayReflections::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::RayReflections");
+        static const HStringId timerId = "RenderPlugins::RayReflections";
+        auto timer = AggregateTimer(timerId);
 
         auto tlasPlugin = m_Renderer->GetPlugin<RenderPlugins::TLAS>(m_Info.TLASPluginName);
         auto objectDataBuffer = tlasPlugin->GetObjectBuffer();
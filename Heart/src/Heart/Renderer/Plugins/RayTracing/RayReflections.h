@@ -17,11 +17,11 @@ namespace Heart::RenderPlugins
     struct RayReflectionsCreateInfo
     {
         Ref<Flourish::Texture> OutputTexture;
-        HString8 FrameDataPluginName;
-        HString8 TLASPluginName;
-        HString8 LightingDataPluginName;
-        HString8 GBufferPluginName;
-        HString8 CollectMaterialsPluginName;
+        HStringId FrameDataPluginName;
+        HStringId TLASPluginName;
+        HStringId LightingDataPluginName;
+        HStringId GBufferPluginName;
+        HStringId CollectMaterialsPluginName;
 
         // Useful when storing traced results on a larger texture
         f32 TraceWidth = 1.f;
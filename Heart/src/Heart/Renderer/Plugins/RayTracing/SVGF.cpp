@@ -115,7 +115,8 @@ namespace Heart::RenderPlugins
     void SVGF::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::SVGF");
+        static const HStringId timerId = "RenderPlugins::SVGF";
+        auto timer = AggregateTimer(timerId);
 
         auto frameDataPlugin = m_Renderer->GetPlugin<RenderPlugins::FrameData>(m_Info.FrameDataPluginName);
         auto frameDataBuffer = frameDataPlugin->GetBuffer();
@@ -17,8 +17,8 @@ namespace Heart::RenderPlugins
     {
         Ref<Flourish::Texture> InputTexture;
         Ref<Flourish::Texture> OutputTexture;
-        HString8 FrameDataPluginName;
-        HString8 GBufferPluginName;
+        HStringId FrameDataPluginName;
+        HStringId GBufferPluginName;
 
         f32 InputUsableFactorWidth = 1.f;
         f32 InputUsableFactorHeight = 1.f;
@@ -47,7 +47,8 @@ namespace Heart::RenderPlugins
     void TLAS::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::TLAS");
+        static const HStringId timerId = "RenderPlugins::TLAS";
+        auto timer = AggregateTimer(timerId);
 
         auto materialsPlugin = m_Renderer->GetPlugin<RenderPlugins::CollectMaterials>(m_Info.CollectMaterialsPluginName);
         const auto& materialMap = materialsPlugin->GetMaterialMap();
@@ -59,7 +60,7 @@ namespace Heart::RenderPlugins
         for (entt::entity entity : meshView)
         {
             const auto& meshComp = meshView.get<MeshComponent>(entity);
-            const auto& transformData = data.Scene->GetCachedTransforms().at(entity);
+            const auto& transformData = data.Scene->GetCachedTransforms().Get(entity);
 
             auto meshAsset = AssetManager::RetrieveAsset<MeshAsset>(meshComp.Mesh);
             if (!meshAsset || !meshAsset->Load(!data.Settings.AsyncAssetLoading)->IsValid())
@@ -80,14 +81,13 @@ namespace Heart::RenderPlugins
                         selectedMaterial = &materialAsset->GetMaterial();
                 }
 
-                u64 materialId = (u64)selectedMaterial;
-                if (materialMap.find(materialId) == materialMap.end())
-                    materialId = 0; // Default material
+                u32* foundMaterial = materialMap.Find((u64)selectedMaterial);
+                u32 materialIndex = foundMaterial ? *foundMaterial : 0; // Default material
 
                 ObjectData objectData {
                     meshData.GetVertexBuffer()->GetBufferGPUAddress(),
                     meshData.GetIndexBuffer()->GetBufferGPUAddress(),
-                    glm::vec4(materialMap.at(materialId))
+                    glm::vec4(materialIndex)
                 };
                 m_ObjectBuffer->SetElements(&objectData, 1, m_Instances.Count());
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Heart/Renderer/RenderPlugin.h"
+#include "Heart/Container/FrameArena.h"
 #include "Flourish/Api/RayTracing/AccelerationStructure.h"
 #include "glm/vec4.hpp"
 
@@ -13,7 +14,7 @@ namespace Heart::RenderPlugins
 {
     struct TLASCreateInfo
     {
-        HString8 CollectMaterialsPluginName;
+        HStringId CollectMaterialsPluginName;
     };
 
     class TLAS : public RenderPlugin
@@ -43,7 +44,7 @@ namespace Heart::RenderPlugins
         TLASCreateInfo m_Info;
 
         u32 m_MaxObjects = 10000;
-        HVector<Flourish::AccelerationStructureInstance> m_Instances;
+        FrameVector<Flourish::AccelerationStructureInstance> m_Instances;
         Ref<Flourish::AccelerationStructure> m_AccelStructure;
         Ref<Flourish::Buffer> m_ObjectBuffer;
     };
@@ -80,7 +80,8 @@ namespace Heart::RenderPlugins
     void RenderEnvironmentMap::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::RenderEnvironmentMap");
+        static const HStringId timerId = "RenderPlugins::RenderEnvironmentMap";
+        auto timer = AggregateTimer(timerId);
 
         m_Stats["GPU Time"].Type = StatType::TimeMS;
         m_Stats["GPU Time"].Data.Float = (float)(m_CommandBuffer->ComputeTimestampDifference(0, 1) * 1e-6);
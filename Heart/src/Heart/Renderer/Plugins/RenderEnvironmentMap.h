@@ -16,7 +16,7 @@ namespace Heart::RenderPlugins
     {
         Ref<Flourish::Texture> OutputTexture;
         bool ClearOutput;
-        HString8 FrameDataPluginName;
+        HStringId FrameDataPluginName;
     };
 
     class RenderEnvironmentMap : public RenderPlugin
@@ -124,7 +124,8 @@ namespace Heart::RenderPlugins
     void SSAO::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::SSAO");
+        static const HStringId timerId = "RenderPlugins::SSAO";
+        auto timer = AggregateTimer(timerId);
 
         m_Stats["GPU Time"].Type = StatType::TimeMS;
         m_Stats["GPU Time"].Data.Float = (float)(m_CommandBuffer->ComputeTimestampDifference(0, 1) * 1e-6);
@@ -16,7 +16,7 @@ namespace Heart::RenderPlugins
 {
     struct SSAOCreateInfo
     {
-        HString8 FrameDataPluginName;
+        HStringId FrameDataPluginName;
 
         Ref<Flourish::Texture> InputDepthTexture;
         Ref<Flourish::Texture> InputNormalsTexture;
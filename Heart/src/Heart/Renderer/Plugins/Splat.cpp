@@ -164,7 +164,8 @@ namespace Heart::RenderPlugins
     void Splat::RenderInternal(const SceneRenderData& data)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::Splat");
+        static const HStringId timerId = "RenderPlugins::Splat";
+        auto timer = AggregateTimer(timerId);
 
         // Compute last frame stats
         float sortTime = 0.f;
@@ -196,7 +197,7 @@ namespace Heart::RenderPlugins
                 break;
 
             const auto& splatComp = splatView.get<SplatComponent>(entity);
-            const auto& transformData = data.Scene->GetCachedTransforms().at(entity);
+            const auto& transformData = data.Scene->GetCachedTransforms().Get(entity);
             auto splatAsset = AssetManager::RetrieveAsset<SplatAsset>(splatComp.Splat);
             if (!splatAsset || !splatAsset->Load(!data.Settings.AsyncAssetLoading)->IsValid())
                 continue;
@@ -20,7 +20,7 @@ namespace Heart::RenderPlugins
         Ref<Flourish::Texture> OutputDepthTexture;
         bool ClearColorOutput;
         bool ClearDepthOutput;
-        HString8 FrameDataPluginName;
+        HStringId FrameDataPluginName;
     };
 
     class Splat : public RenderPlugin
@@ -98,7 +98,8 @@ namespace Heart::RenderPlugins
     {
     /*
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("RenderPlugins::TransparencyComposite");
+        static const HStringId timerId = "RenderPlugins::TransparencyComposite";
+        auto timer = AggregateTimer(timerId);
 
         // TODO: this could probably be static
         m_ResourceSet->BindTexture(0, m_AccumTexture.get());
@@ -14,7 +14,7 @@ namespace Heart::RenderPlugins
 {
     struct TransparencyCompositeCreateInfo
     {
-        HString8 FrameDataPluginName;
+        HStringId FrameDataPluginName;
     };
 
     class TransparencyComposite : public RenderPlugin
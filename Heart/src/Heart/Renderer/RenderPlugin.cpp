@@ -24,30 +24,9 @@ namespace Heart
         m_Task = TaskManager::Schedule(
             [this](){ InitializeInternal(); },
             Task::Priority::High,
-            m_DependencyTasks,
-            m_Name
-        );
-    }
-
-    void RenderPlugin::Render(const SceneRenderData& data)
-    {
-        if (App::Get().GetFrameCount() == m_LastRenderFrame)
-            return;
-        m_LastRenderFrame = App::Get().GetFrameCount();
-        
-        m_DependencyTasks.Clear();
-        for (const auto& depName : m_CPUGraphData.Dependencies)
-        {
-            auto dep = m_Renderer->GetPlugin(depName);
-            dep->Render(data);
-            m_DependencyTasks.Add(dep->GetTask());
-        }
-        
-        m_Task = TaskManager::Schedule(
-            [this, data](){ RenderInternal(data); },
-            Task::Priority::High,
-            m_DependencyTasks,
-            m_Name
+            m_DependencyTasks.Data(),
+            m_DependencyTasks.Count(),
+            m_Name.GetString()
         );
     }
 
@@ -68,17 +47,18 @@ namespace Heart
         m_Task = TaskManager::Schedule(
             [this](){ ResizeInternal(); },
             Task::Priority::High,
-            m_DependencyTasks,
-            m_Name
+            m_DependencyTasks.Data(),
+            m_DependencyTasks.Count(),
+            m_Name.GetString()
         );
     }
 
-    void RenderPlugin::AddDependency(const HString8& name, GraphDependencyType depType)
+    void RenderPlugin::AddDependency(HStringId name, GraphDependencyType depType)
     {
         GetGraphData(depType).Dependencies.insert(name);
     }
 
-    void RenderPlugin::AddInitDependency(const HString8& name)
+    void RenderPlugin::AddInitDependency(HStringId name)
     {
         m_InitDependencies.insert(name);
     }
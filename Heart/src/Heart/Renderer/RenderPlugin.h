@@ -2,7 +2,9 @@
 
 #include "Heart/Task/Task.h"
 #include "Heart/Container/HString8.h"
+#include "Heart/Container/HStringId.h"
 #include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HSmallVector.hpp"
 #include "Heart/Core/UUID.h"
 #include "Flourish/Api/CommandBuffer.h"
 #include "Flourish/Api/Texture.h"
@@ -32,8 +34,8 @@ namespace Heart
 
         struct GraphData
         {
-            std::unordered_set<HString8> Dependencies;
-            HVector<HString8> Dependents;
+            std::unordered_set<HStringId> Dependencies;
+            HVector<HStringId> Dependents;
             u32 MaxDepth = 0;
         };
 
@@ -54,11 +56,10 @@ namespace Heart
         {}
 
         void Initialize();
-        void Render(const SceneRenderData& data);
         void Resize();
         
-        void AddDependency(const HString8& name, GraphDependencyType depType);
-        void AddInitDependency(const HString8& name);
+        void AddDependency(HStringId name, GraphDependencyType depType);
+        void AddInitDependency(HStringId name);
 
         GraphData& GetGraphData(GraphDependencyType depType);
         
@@ -83,17 +84,16 @@ namespace Heart
         Task m_Task;
         bool m_Active = true;
         bool m_Initialized = false;
-        HString8 m_Name;
+        HStringId m_Name;
         UUID m_UUID = UUID();
-        u64 m_LastRenderFrame = 0;
         u64 m_LastResizeFrame = 0;
-        HVector<Task> m_DependencyTasks;
+        HSmallVector<Task, 4> m_DependencyTasks;
         std::map<HString8, Stat> m_Stats;
         SceneRenderer* m_Renderer;
         Ref<Flourish::CommandBuffer> m_CommandBuffer;
         Ref<Flourish::Texture> m_OutputTexture;
         std::map<HString8, Ref<Flourish::Texture>> m_DebugTextures;
-        std::unordered_set<HString8> m_InitDependencies;
+        std::unordered_set<HStringId> m_InitDependencies;
         GraphData m_CPUGraphData;
         GraphData m_GPUGraphData;
         Flourish::RenderGraphNodeBuilder m_GPUGraphNodeBuilder;
@@ -27,6 +27,8 @@ namespace Heart
     {
         UnsubscribeFromEmitter(&Window::GetMainWindow());
 
+        m_RenderTaskGraph.Clear();
+
         HE_ENGINE_LOG_TRACE("SceneRenderer cleanup");
     }
 
@@ -43,6 +45,7 @@ namespace Heart
     {
         RebuildGraphInternal(GraphDependencyType::CPU);
         RebuildGraphInternal(GraphDependencyType::GPU);
+        RebuildTaskGraph();
 
         m_RenderGraph->Clear();
 
@@ -88,13 +91,14 @@ namespace Heart
             RebuildGraph();
         }
 
+        // Plugins read the render data from their tasks, so the previous frame must be done with it
+        m_RenderTaskGraph.Wait();
+        m_RenderData = data;
+
         TaskGroup group;
-        for (const auto& leaf : m_CPUGraphData.Leaves)
-        {
-            auto& plugin = m_Plugins[leaf];
-            plugin->Render(data);
-            group.AddTask(plugin->GetTask());
-        }
+        group.AddTask(m_RenderTaskGraph.Launch());
+        for (u32 i = 0; i < m_RenderTaskGraphPlugins.Count(); i++)
+            m_RenderTaskGraphPlugins[i]->m_Task = m_RenderTaskGraph.GetNodeTask(i);
 
         return group;
     }
@@ -168,6 +172,30 @@ namespace Heart
         }
     }
 
+    void SceneRenderer::RebuildTaskGraph()
+    {
+        m_RenderTaskGraph.Clear();
+        m_RenderTaskGraphPlugins.Clear();
+
+        std::unordered_map<HStringId, u32> nodes;
+        for (const auto& pair : m_Plugins)
+        {
+            RenderPlugin* plugin = pair.second.get();
+            nodes[pair.first] = m_RenderTaskGraph.AddNode(
+                [this, plugin](){ plugin->RenderInternal(m_RenderData); },
+                Task::Priority::High,
+                plugin->GetName().GetString()
+            );
+            m_RenderTaskGraphPlugins.Add(plugin);
+        }
+
+        for (const auto& pair : m_Plugins)
+            for (const auto& dep : pair.second->GetGraphData(GraphDependencyType::CPU).Dependencies)
+                m_RenderTaskGraph.AddDependency(nodes[pair.first], nodes[dep]);
+
+        m_RenderTaskGraph.Compile();
+    }
+
     void SceneRenderer::InitializeRegisteredPlugins()
     {
         TaskGroup group;
@@ -3,8 +3,10 @@
 #include "glm/vec3.hpp"
 #include "Heart/Events/EventEmitter.h"
 #include "Heart/Task/Task.h"
+#include "Heart/Task/TaskGraph.h"
 #include "Heart/Container/HVector.hpp"
 #include "Heart/Container/HString8.h"
+#include "Heart/Container/HStringId.h"
 #include "Heart/Scene/RenderScene.h"
 #include "Heart/Core/Camera.h"
 #include "Heart/Renderer/EnvironmentMap.h"
@@ -46,8 +48,8 @@ namespace Heart
     public:
         struct GraphData
         {
-            HVector<HString8> Leaves;
-            HVector<HString8> Roots;
+            HVector<HStringId> Leaves;
+            HVector<HStringId> Roots;
             u32 MaxDepth = 0;
         };
 
@@ -69,13 +71,13 @@ namespace Heart
             return plugin;
         }
 
-        inline RenderPlugin* GetPlugin(const HString8& name)
+        inline RenderPlugin* GetPlugin(HStringId name)
         {
             return m_Plugins[name].get();
         }
 
         template<typename Plugin>
-        inline Plugin* GetPlugin(const HString8& name)
+        inline Plugin* GetPlugin(HStringId name)
         {
             auto found = m_Plugins.find(name);
             if (found == m_Plugins.end()) return nullptr;
@@ -112,15 +114,22 @@ namespace Heart
         void Resize();
         void RebuildGraph();
         void RebuildGraphInternal(GraphDependencyType depType);
+        void RebuildTaskGraph();
 
     private:
-        std::unordered_map<HString8, Ref<RenderPlugin>> m_Plugins;
+        std::unordered_map<HStringId, Ref<RenderPlugin>> m_Plugins;
         bool m_ShouldResize = false;
         bool m_ShouldRebuild = false;
         bool m_Debug = false;
         GraphData m_CPUGraphData;
         GraphData m_GPUGraphData;
 
+        // Compiled from the plugin CPU dependencies whenever the graph is rebuilt and
+        // launched once per frame. Plugin nodes read the frame's data from m_RenderData
+        TaskGraph m_RenderTaskGraph;
+        HVector<RenderPlugin*> m_RenderTaskGraphPlugins;
+        SceneRenderData m_RenderData;
+
         Ref<Flourish::RenderGraph> m_RenderGraph;
     };
 }
@@ -101,7 +101,7 @@ namespace Heart
             vertexOffset += 4;
         }
 
-        ComputedMesh = Mesh(vertices, indices, 0);
+        ComputedMesh = Mesh(std::move(vertices), std::move(indices), 0);
 
         Recomputing = false;
     }
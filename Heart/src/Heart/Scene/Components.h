@@ -3,6 +3,7 @@
 #include "Heart/Scripting/ScriptEntityInstance.h"
 #include "Heart/Scripting/ScriptComponentInstance.h"
 #include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HSmallVector.hpp"
 #include "Heart/Container/HString.h"
 #include "Heart/Core/UUID.h"
 #include "Heart/Renderer/Mesh.h"
@@ -44,7 +45,7 @@ namespace Heart
 
     struct ChildrenComponent
     {
-        HVector<UUID> Children;
+        HSmallVector<UUID, 4> Children;
     };
 
     struct TransformComponent
@@ -75,7 +76,7 @@ namespace Heart
     struct MeshComponent
     {
         UUID Mesh = 0;
-        HVector<UUID> Materials;
+        HSmallVector<UUID, 4> Materials;
     };
 
     struct SplatComponent
@@ -123,7 +123,7 @@ namespace Heart
         return HasComponent<ChildrenComponent>() && GetComponent<ChildrenComponent>().Children.Count() > 0;
     }
 
-    const HVector<UUID>& Entity::GetChildren()
+    const HSmallVector<UUID, 4>& Entity::GetChildren()
     {
         if (!HasComponent<ChildrenComponent>())
             AddComponent<ChildrenComponent>();
@@ -44,7 +44,7 @@ namespace Heart
         void ApplyRotation(glm::vec3 rot, bool cache = true);
 
         bool HasChildren();
-        const HVector<UUID>& GetChildren();
+        const HSmallVector<UUID, 4>& GetChildren();
         void AddChild(UUID uuid, bool cache = true);
         void RemoveChild(UUID uuid, bool cache = true);
         UUID GetParent() const;
@@ -14,7 +14,8 @@ namespace Heart
 
     void RenderScene::CopyFromScene(Scene* scene)
     {
-        auto timer = AggregateTimer("RenderScene::CopyFromScene");
+        static const HStringId timerId = "RenderScene::CopyFromScene";
+        auto timer = AggregateTimer(timerId);
 
         Cleanup();
 
@@ -36,22 +37,23 @@ namespace Heart
         if (srcText.size() > 0)
         {
             auto dstText = m_Registry.view<TextComponent>();
-            auto job = JobManager::ScheduleIter(
-                dstText.begin(),
-                dstText.end(),
-                [dstText, scene](size_t index)
+            const auto* textEntities = dstText.handle();
+            auto job = JobManager::ParallelFor(
+                0,
+                textEntities->size(),
+                1,
+                [dstText, textEntities, scene](size_t index)
                 {
-                    auto& textComp = dstText.get<TextComponent>((entt::entity)index);
+                    auto entity = textEntities->data()[index];
+                    auto& textComp = dstText.get<TextComponent>(entity);
+                    if (!textComp.Font || textComp.Text.IsEmpty() || textComp.ComputedMesh.GetVertexBuffer())
+                        return;
+
                     textComp.RecomputeRenderData();
                     
                     // Update original text component with new data so that we can cache the computed result
-                    auto& ogTextComp = scene->GetRegistry().get<TextComponent>((entt::entity)index);
+                    auto& ogTextComp = scene->GetRegistry().get<TextComponent>(entity);
                     ogTextComp.ComputedMesh = textComp.ComputedMesh;
-                },
-                [dstText](size_t index)
-                {
-                    const auto& textComp = dstText.get<TextComponent>((entt::entity)index);
-                    return textComp.Font && !textComp.Text.IsEmpty() && !textComp.ComputedMesh.GetVertexBuffer();
                 }
             );
 
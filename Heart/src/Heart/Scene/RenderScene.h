@@ -26,6 +26,6 @@ namespace Heart
 
     private:
         entt::registry m_Registry;
-        std::unordered_map<entt::entity, Scene::CachedTransformData> m_CachedTransforms;
+        HFlatMap<entt::entity, Scene::CachedTransformData> m_CachedTransforms;
     };
 }
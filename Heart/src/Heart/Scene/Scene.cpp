@@ -189,8 +189,8 @@ namespace Heart
             instance.Destroy();
         }
             
-        m_CachedTransforms.erase(entity.GetHandle());
-        m_UUIDMap.erase(entity.GetUUID());
+        m_CachedTransforms.Remove(entity.GetHandle());
+        m_UUIDMap.Remove(entity.GetUUID());
         
         if (m_IsRuntime && !forceCleanup)
         {
@@ -383,6 +383,8 @@ namespace Heart
     Ref<Scene> Scene::Clone()
     {
         Ref<Scene> newScene = CreateRef<Scene>();
+        newScene->m_UUIDMap.Reserve(m_UUIDMap.Count());
+        newScene->m_CachedTransforms.Reserve(m_CachedTransforms.Count());
 
         // Copy each entity & associated data to the new registry
         // TODO: look into speeding up / parallelization
@@ -479,25 +481,52 @@ namespace Heart
     void Scene::OnUpdateRuntime(Timestep ts)
     {
         HE_PROFILE_FUNCTION();
-        auto timer = AggregateTimer("Scene::OnUpdateRuntime");
-        
-        // Update physics
-        auto runTimer = AggregateTimer("Scene::OnUpdateRuntime - Physics Step");
+        static const HStringId timerId = "Scene::OnUpdateRuntime";
+        auto timer = AggregateTimer(timerId);
+
+        // The stages run serially on the calling thread rather than being spread across workers
+        // since scripts and collision callbacks can reach asset loads and GPU work through the
+        // native callbacks
+        UpdatePhysicsStep(ts);
+        UpdatePostPhysics();
+        UpdateScripts(ts);
+        UpdateCleanup();
+
+        // Finalize transform data
+        static const HStringId finalizeTimerId = "Scene::OnUpdateRuntime - Finalize Transforms";
+        auto runTimer = AggregateTimer(finalizeTimerId);
+        CacheDirtyTransforms();
+    }
+
+    void Scene::UpdatePhysicsStep(Timestep ts)
+    {
+        static const HStringId timerId = "Scene::OnUpdateRuntime - Physics Step";
+        auto runTimer = AggregateTimer(timerId);
         m_PhysicsWorld.Step(ts.StepSeconds());
-        runTimer.Finish();
-        
+    }
+
+    void Scene::UpdatePostPhysics()
+    {
         // Update positions of physics entities to reflect physics body position
-        runTimer = AggregateTimer("Scene::OnUpdateRuntime - Post Physics");
+        static const HStringId timerId = "Scene::OnUpdateRuntime - Post Physics";
+        auto runTimer = AggregateTimer(timerId);
         auto physView = m_Registry.view<CollisionComponent, TransformComponent>();
-        JobManager::ScheduleIter(
-            physView.begin(),
-            physView.end(),
-            [this, &physView](size_t _entity)
+        const auto* physEntities = physView.handle();
+        JobManager::ParallelFor(
+            0,
+            physEntities->size(),
+            64,
+            [this, &physView, physEntities](size_t index)
             {
-                auto entity = (entt::entity)_entity;
+                auto entity = physEntities->data()[index];
+                if (!physView.contains(entity)) return;
 
                 auto& bodyComp = physView.get<CollisionComponent>(entity);
                 PhysicsBody* body = m_PhysicsWorld.GetBody(bodyComp.BodyId);
+
+                // Static & ghost objects will never have an updated position so skip
+                if (body->GetBodyType() != PhysicsBodyType::Rigid || body->GetMass() == 0.f)
+                    return;
                 
                 auto& transformComp = physView.get<TransformComponent>(entity);
                 
@@ -511,7 +540,7 @@ namespace Heart
                 }
                 
                 auto bodyRot = body->GetRotation();
-                auto eq = glm::equal(m_CachedTransforms[entity].Quat, bodyRot, 0.0001f);
+                auto eq = glm::equal(m_CachedTransforms.Get(entity).Quat, bodyRot, 0.0001f);
                 if (!eq.x || !eq.y || !eq.z || !eq.w)
                 {
                     transformComp.Rotation = glm::degrees(glm::eulerAngles(bodyRot));
@@ -521,48 +550,38 @@ namespace Heart
                 // Manual cache here to preserve velocities
                 if (dirty)
                     CacheEntityTransform({ this, entity }, true, false);
-            },
-            [this, &physView](size_t _entity)
-            {
-                auto entity = (entt::entity)_entity;
-                
-                auto& bodyComp = physView.get<CollisionComponent>(entity);
-                PhysicsBody* body = m_PhysicsWorld.GetBody(bodyComp.BodyId);
-                
-                // Static & ghost objects will never have an updated position so skip
-                return body->GetBodyType() == PhysicsBodyType::Rigid && body->GetMass() != 0.f;
             }
         ).Wait();
-        runTimer.Finish();
-        
+    }
+
+    void Scene::UpdateScripts(Timestep ts)
+    {
         // Call OnUpdate lifecycle method
-        runTimer = AggregateTimer("Scene::OnUpdateRuntime - Scripts");
+        static const HStringId timerId = "Scene::OnUpdateRuntime - Scripts";
+        auto runTimer = AggregateTimer(timerId);
         auto scriptView = m_Registry.view<ScriptComponent>();
         for (auto entity : scriptView)
         {
             auto& scriptComp = scriptView.get<ScriptComponent>(entity);
             scriptComp.Instance.OnUpdate(ts);
         }
-        runTimer.Finish();
-        
+    }
+
+    void Scene::UpdateCleanup()
+    {
         // Cleanup destroyed entities
-        runTimer = AggregateTimer("Scene::OnUpdateRuntime - Cleanup");
+        static const HStringId timerId = "Scene::OnUpdateRuntime - Cleanup";
+        auto runTimer = AggregateTimer(timerId);
         auto destroyedView = m_Registry.view<DestroyedComponent>();
         for (auto entity : destroyedView)
             CleanupEntity({ this, entity });
-        runTimer.Finish();
-
-        // Finalize transform data
-        runTimer = AggregateTimer("Scene::OnUpdateRuntime - Finalize Transforms");
-        CacheDirtyTransforms();
-        runTimer.Finish();
     }
 
     Entity Scene::GetEntityFromUUID(UUID uuid)
     {
-        auto found = m_UUIDMap.find(uuid);
-        if (found == m_UUIDMap.end()) return Entity();
-        return { this, found->second };
+        auto found = m_UUIDMap.Find(uuid);
+        if (!found) return Entity();
+        return { this, *found };
     }
     Entity Scene::GetEntityFromName(const HStringView8& name)
     {
@@ -584,48 +603,63 @@ namespace Heart
     
     Entity Scene::GetEntityFromUUIDUnchecked(UUID uuid)
     {
-        return { this, m_UUIDMap.at(uuid) };
+        return { this, m_UUIDMap.Get(uuid) };
     }
 
     void Scene::CacheDirtyTransforms()
     {
         auto transformView = m_Registry.view<TransformComponent>();
-        JobManager::ScheduleIter(
-            transformView.begin(),
-            transformView.end(),
-            [this, &transformView](size_t _entity)
+        const auto* transformEntities = transformView.handle();
+        size_t count = transformEntities->size();
+
+        // Find the roots first since caching clears the dirty flags that the search reads
+        m_DirtyTransformRoots.Resize(count, false);
+        JobManager::ParallelFor(
+            0,
+            count,
+            256,
+            [this, transformEntities](size_t index)
             {
-                auto entity = (entt::entity)_entity;
-                CacheEntityTransform({ this, entity }, true, true);
-            },
-            [this, &transformView](size_t _entity)
+                m_DirtyTransformRoots[index] = IsDirtyTransformRoot({ this, transformEntities->data()[index] });
+            }
+        ).Wait();
+
+        JobManager::ParallelFor(
+            0,
+            count,
+            32,
+            [this, transformEntities](size_t index)
             {
-                // We only want to update the highest level components that are dirty since
-                // they will propagate
+                if (!m_DirtyTransformRoots[index]) return;
+                CacheEntityTransform({ this, transformEntities->data()[index] }, true, true);
+            }
+        ).Wait();
+    }
 
-                Entity entity = { this, (entt::entity)_entity };
+    bool Scene::IsDirtyTransformRoot(Entity entity)
+    {
+        // We only want to update the highest level components that are dirty since
+        // they will propagate
 
-                if (!transformView.get<TransformComponent>(entity.GetHandle()).Dirty)
-                    return false;
+        if (!entity.GetComponent<TransformComponent>().Dirty)
+            return false;
 
-                if (entity.HasComponent<CollisionComponent>())
-                    return true;
+        if (entity.HasComponent<CollisionComponent>())
+            return true;
 
-                // Stop checking if the parent has a collision component since we
-                // don't follow its transform
-                Entity parent = GetEntityFromUUID(entity.GetParent());
-                while (parent.IsValid())
-                {
-                    if (transformView.get<TransformComponent>(parent.GetHandle()).Dirty)
-                        return false;
-                    if (parent.HasComponent<CollisionComponent>())
-                        break;
-                    parent = GetEntityFromUUID(parent.GetParent());
-                }
+        // Stop checking if the parent has a collision component since we
+        // don't follow its transform
+        Entity parent = GetEntityFromUUID(entity.GetParent());
+        while (parent.IsValid())
+        {
+            if (parent.GetComponent<TransformComponent>().Dirty)
+                return false;
+            if (parent.HasComponent<CollisionComponent>())
+                break;
+            parent = GetEntityFromUUID(parent.GetParent());
+        }
 
-                return true;
-            }
-        ).Wait();
+        return true;
     }
 
     void Scene::CollisionStartCallback(UUID id0, UUID id1)
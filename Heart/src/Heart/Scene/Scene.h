@@ -3,6 +3,8 @@
 #include "Heart/Renderer/EnvironmentMap.h"
 #include "Heart/Core/Timestep.h"
 #include "Heart/Core/UUID.h"
+#include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HFlatMap.hpp"
 #include "Heart/Physics/PhysicsWorld.h"
 #include "entt/entt.hpp"
 #include "glm/mat4x4.hpp"
@@ -84,14 +86,21 @@ namespace Heart
         void RemoveChild(UUID parentUUID, UUID childUUID);
         void DestroyChildren(Entity parent);
         Entity GetEntityFromUUIDUnchecked(UUID uuid);
+        bool IsDirtyTransformRoot(Entity entity);
+
+        void UpdatePhysicsStep(Timestep ts);
+        void UpdatePostPhysics();
+        void UpdateScripts(Timestep ts);
+        void UpdateCleanup();
         
         void CollisionStartCallback(UUID id0, UUID id1);
         void CollisionEndCallback(UUID id0, UUID id1);
         
     private:
         entt::registry m_Registry;
-        std::unordered_map<UUID, entt::entity> m_UUIDMap;
-        std::unordered_map<entt::entity, CachedTransformData> m_CachedTransforms;
+        HFlatMap<UUID, entt::entity> m_UUIDMap;
+        HFlatMap<entt::entity, CachedTransformData> m_CachedTransforms;
+        HVector<u8> m_DirtyTransformRoots;
         PhysicsWorld m_PhysicsWorld;
         Ref<EnvironmentMap> m_EnvironmentMap; // TODO: move this out of scene
         bool m_IsRuntime = false;
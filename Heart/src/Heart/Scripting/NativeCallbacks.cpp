@@ -52,9 +52,9 @@ HE_INTEROP_EXPORT void Native_HString_Copy(Heart::HString* dst, const Heart::HSt
 
 HE_INTEROP_EXPORT void Native_HArray_Init(Heart::HArray* array)
 {
-    // Reserve base elems when initializing from c# so ptr is always valid
+    // Storage is allocated on the first add. C# checks for a null pointer before reading
     array->~HArray();
-    HE_PLACEMENT_NEW(array, Heart::HArray, 16, false);
+    HE_PLACEMENT_NEW(array, Heart::HArray);
 }
 
 HE_INTEROP_EXPORT void Native_HArray_Destroy(Heart::HArray* array)
@@ -376,11 +376,13 @@ HE_INTEROP_EXPORT void Native_ParentComponent_SetParent(u32 entityHandle, Heart:
 }
 
 // Children component
-HE_INTEROP_EXPORT void Native_ChildrenComponent_Get(u32 entityHandle, Heart::Scene* sceneHandle, Heart::UUID** outComp)
+HE_INTEROP_EXPORT void Native_ChildrenComponent_Get(u32 entityHandle, Heart::Scene* sceneHandle, Heart::UUID** outData, u32* outCount)
 { 
     ASSERT_ENTITY_IS_VALID();
     Heart::Entity entity(sceneHandle, entityHandle);
-    *outComp = entity.GetChildren().Data();
+    auto& children = entity.GetChildren();
+    *outData = children.Data();
+    *outCount = children.Count();
 }
 
 HE_INTEROP_EXPORT void Native_ChildrenComponent_AddChild(u32 entityHandle, Heart::Scene* sceneHandle, Heart::UUID uuid)
@@ -402,6 +404,16 @@ HE_INTEROP_EXPORT void Native_ChildrenComponent_RemoveChild(u32 entityHandle, He
 // Mesh component
 EXPORT_COMPONENT_BASIC_FNS(MeshComponent);
 
+HE_INTEROP_EXPORT void Native_MeshComponent_GetMaterials(u32 entityHandle, Heart::Scene* sceneHandle, Heart::UUID** outData, u32* outCount)
+{
+    ASSERT_ENTITY_IS_VALID();
+    ASSERT_ENTITY_HAS_COMPONENT(MeshComponent);
+    Heart::Entity entity(sceneHandle, entityHandle);
+    auto& materials = entity.GetComponent<Heart::MeshComponent>().Materials;
+    *outData = materials.Data();
+    *outCount = materials.Count();
+}
+
 HE_INTEROP_EXPORT void Native_MeshComponent_AddMaterial(u32 entityHandle, Heart::Scene* sceneHandle, Heart::UUID material)
 {
     ASSERT_ENTITY_IS_VALID();
@@ -684,6 +696,7 @@ void* NativeCallbacks[] = {
     (void*)&Native_MeshComponent_Exists,
     (void*)&Native_MeshComponent_Add,
     (void*)&Native_MeshComponent_Remove,
+    (void*)&Native_MeshComponent_GetMaterials,
     (void*)&Native_MeshComponent_AddMaterial,
     (void*)&Native_MeshComponent_RemoveMaterial,
     (void*)&Native_NameComponent_Get,
@@ -23,6 +23,6 @@ namespace Heart
         HArray outFields;
         ScriptingEngine::s_CoreCallbacks.PluginReflection_GetClientSerializableFields(&m_FullName, &outFields);
         for (u32 i = 0; i < outFields.Count(); i++)
-            m_SerializableFields.Add(outFields[i].String().Convert(HString::Encoding::UTF8));
+            m_SerializableFields.Add(outFields[i].StringView().Convert(HString::Encoding::UTF8));
     }   
 }
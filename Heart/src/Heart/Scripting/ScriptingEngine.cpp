@@ -348,7 +348,7 @@ namespace Heart
             auto ids = outArgs[index * 2 + 1].Array();
             for (u32 i = 0; i < classes.Count(); i++)
             {
-                auto convertedString = classes[i].String().Convert(HString::Encoding::UTF8);
+                auto convertedString = classes[i].StringView().Convert(HString::Encoding::UTF8);
                 s64 id = ids[i].Int();
                 s_NameToId[convertedString] = id;
                 target[id] = ScriptClass(convertedString, 0);
@@ -0,0 +1,337 @@
+#include "hepch.h"
+#include "CpuTopology.h"
+
+#if defined(HE_PLATFORM_LINUX) || defined(HE_PLATFORM_ANDROID)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace Heart
+{
+    const HVector<CpuTopology::LogicalCore>& CpuTopology::GetLogicalCores()
+    {
+        std::call_once(s_DetectFlag, &CpuTopology::Detect);
+        return s_LogicalCores;
+    }
+
+    u32 CpuTopology::GetPhysicalCoreCount()
+    {
+        std::call_once(s_DetectFlag, &CpuTopology::Detect);
+        return s_PhysicalCoreCount;
+    }
+
+    u32 CpuTopology::GetNumaNodeCount()
+    {
+        std::call_once(s_DetectFlag, &CpuTopology::Detect);
+        return s_NumaNodeCount;
+    }
+
+    HVector<u32> CpuTopology::GetPreferredCores(bool includeSmtSiblings)
+    {
+        HVector<LogicalCore> cores = GetLogicalCores();
+        std::sort(cores.begin(), cores.end(), [](const LogicalCore& a, const LogicalCore& b)
+        {
+            if (a.IsPrimary != b.IsPrimary) return a.IsPrimary;
+            if (a.NumaNode != b.NumaNode) return a.NumaNode < b.NumaNode;
+            return a.Id < b.Id;
+        });
+
+        HVector<u32> ids;
+        for (auto& core : cores)
+            if (core.IsPrimary || includeSmtSiblings)
+                ids.Add(core.Id);
+
+        return ids;
+    }
+
+    bool CpuTopology::PinCurrentThread(u32 logicalCore)
+    {
+        #if defined(HE_PLATFORM_LINUX) || defined(HE_PLATFORM_ANDROID)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(logicalCore, &set);
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+        #elif defined(HE_PLATFORM_WINDOWS)
+            if (logicalCore >= 64) return false;
+            return SetThreadAffinityMask(GetCurrentThread(), 1ull << logicalCore) != 0;
+        #endif
+
+        return false;
+    }
+
+    u32 CpuTopology::GetNumaNode(u32 logicalCore)
+    {
+        std::call_once(s_DetectFlag, &CpuTopology::Detect);
+        if (logicalCore >= s_NodeOfCore.Count()) return 0;
+        return s_NodeOfCore[logicalCore];
+    }
+
+    u32 CpuTopology::GetCurrentNumaNode()
+    {
+        #if defined(HE_PLATFORM_LINUX) || defined(HE_PLATFORM_ANDROID)
+            int cpu = sched_getcpu();
+            if (cpu >= 0)
+                return GetNumaNode(static_cast<u32>(cpu));
+        #elif defined(HE_PLATFORM_WINDOWS)
+            return GetNumaNode(GetCurrentProcessorNumber());
+        #endif
+
+        return 0;
+    }
+
+    void CpuTopology::Detect()
+    {
+        bool detected = false;
+
+        #if defined(HE_PLATFORM_LINUX) || defined(HE_PLATFORM_ANDROID)
+            detected = DetectFromSysfs("/sys/devices/system");
+            if (!detected)
+                detected = DetectFromCpuinfo("/proc/cpuinfo");
+        #elif defined(HE_PLATFORM_WINDOWS)
+            DWORD length = 0;
+            GetLogicalProcessorInformation(nullptr, &length);
+            HVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos;
+            infos.Resize(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION), false);
+            if (length > 0 && GetLogicalProcessorInformation(infos.Data(), &length))
+            {
+                // Only the first processor group is visible here, which covers up to 64 processors
+                HVector<u32> nodes;
+                nodes.Resize(64, false);
+                for (u32 i = 0; i < 64; i++)
+                    nodes[i] = 0;
+                for (auto& info : infos)
+                    if (info.Relationship == RelationNumaNode)
+                        for (u32 i = 0; i < 64; i++)
+                            if (info.ProcessorMask & (1ull << i))
+                                nodes[i] = info.NumaNode.NodeNumber;
+
+                u32 physicalCore = 0;
+                for (auto& info : infos)
+                {
+                    if (info.Relationship != RelationProcessorCore) continue;
+                    for (u32 i = 0; i < 64; i++)
+                        if (info.ProcessorMask & (1ull << i))
+                            s_LogicalCores.Add({ i, physicalCore, nodes[i], false });
+                    physicalCore++;
+                }
+                detected = !s_LogicalCores.IsEmpty();
+            }
+        #endif
+
+        if (!detected)
+            DetectFallback();
+
+        FilterToProcessAffinity();
+        Finalize();
+
+        HE_ENGINE_LOG_INFO(
+            "Detected {0} logical cores, {1} physical cores and {2} NUMA nodes",
+            s_LogicalCores.Count(), s_PhysicalCoreCount, s_NumaNodeCount
+        );
+    }
+
+    bool CpuTopology::DetectFromSysfs(const HStringView8& root)
+    {
+        std::string cpuRoot = std::string(root.Data(), root.Count()) + "/cpu/";
+        std::ifstream onlineFile(cpuRoot + "online");
+        std::string online;
+        if (!std::getline(onlineFile, online))
+            return false;
+
+        HVector<u32> cpus = ParseCpuList(HStringView8(online.data(), online.size()));
+        if (cpus.IsEmpty())
+            return false;
+
+        // Cores are only unique within a package, so key them on both
+        std::unordered_map<u64, u32> physicalCores;
+        for (u32 cpu : cpus)
+        {
+            std::string topology = cpuRoot + "cpu" + std::to_string(cpu) + "/topology/";
+            u32 coreId = cpu;
+            u32 packageId = 0;
+            ReadNumber(topology + "core_id", coreId);
+            ReadNumber(topology + "physical_package_id", packageId);
+
+            u64 key = (static_cast<u64>(packageId) << 32) | coreId;
+            auto found = physicalCores.find(key);
+            u32 physicalCore = found != physicalCores.end() ? found->second : physicalCores.size();
+            physicalCores[key] = physicalCore;
+
+            s_LogicalCores.Add({ cpu, physicalCore, 0, false });
+        }
+
+        // Node ids can be sparse, so they are renumbered in order of appearance
+        std::string nodeRoot = std::string(root.Data(), root.Count()) + "/node/";
+        std::ifstream nodesFile(nodeRoot + "online");
+        std::string nodes;
+        if (std::getline(nodesFile, nodes))
+        {
+            u32 denseNode = 0;
+            for (u32 node : ParseCpuList(HStringView8(nodes.data(), nodes.size())))
+            {
+                std::ifstream listFile(nodeRoot + "node" + std::to_string(node) + "/cpulist");
+                std::string list;
+                if (!std::getline(listFile, list))
+                    continue;
+
+                for (u32 cpu : ParseCpuList(HStringView8(list.data(), list.size())))
+                    for (auto& core : s_LogicalCores)
+                        if (core.Id == cpu)
+                            core.NumaNode = denseNode;
+                denseNode++;
+            }
+        }
+
+        return true;
+    }
+
+    bool CpuTopology::DetectFromCpuinfo(const HStringView8& path)
+    {
+        std::ifstream file(path.Data());
+        if (!file.is_open())
+            return false;
+
+        // Each processor is a block of "key : value" lines
+        std::unordered_map<u64, u32> physicalCores;
+        u32 processor = 0, packageId = 0, coreId = 0;
+        bool inBlock = false;
+        auto flush = [&]()
+        {
+            if (!inBlock) return;
+            u64 key = (static_cast<u64>(packageId) << 32) | coreId;
+            auto found = physicalCores.find(key);
+            u32 physicalCore = found != physicalCores.end() ? found->second : physicalCores.size();
+            physicalCores[key] = physicalCore;
+            s_LogicalCores.Add({ processor, physicalCore, 0, false });
+            inBlock = false;
+        };
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            size_t separator = line.find(':');
+            if (separator == std::string::npos)
+            {
+                flush();
+                continue;
+            }
+
+            std::string key = line.substr(0, line.find_last_not_of(" \t", separator - 1) + 1);
+            u32 value = static_cast<u32>(strtoul(line.c_str() + separator + 1, nullptr, 10));
+            if (key == "processor")
+            {
+                flush();
+                processor = value;
+                coreId = value;
+                packageId = 0;
+                inBlock = true;
+            }
+            else if (key == "physical id")
+                packageId = value;
+            else if (key == "core id")
+                coreId = value;
+        }
+        flush();
+
+        return !s_LogicalCores.IsEmpty();
+    }
+
+    void CpuTopology::DetectFallback()
+    {
+        s_LogicalCores.Clear();
+        u32 count = std::max(std::thread::hardware_concurrency(), 1u);
+        for (u32 i = 0; i < count; i++)
+            s_LogicalCores.Add({ i, i, 0, false });
+    }
+
+    void CpuTopology::FilterToProcessAffinity()
+    {
+        #if defined(HE_PLATFORM_LINUX) || defined(HE_PLATFORM_ANDROID)
+            // The host may have far more processors than the process is allowed to run on, i.e.
+            // when confined by a cgroup cpuset in a container. Workers are sized and pinned from
+            // this list, so drop anything outside of the allowed set
+            u32 maxId = 0;
+            for (auto& core : s_LogicalCores)
+                maxId = std::max(maxId, core.Id);
+
+            cpu_set_t* set = CPU_ALLOC(maxId + 1);
+            if (!set) return;
+            size_t setSize = CPU_ALLOC_SIZE(maxId + 1);
+            CPU_ZERO_S(setSize, set);
+
+            // Queried for the process rather than the calling thread, which may already be pinned
+            if (sched_getaffinity(getpid(), setSize, set) == 0)
+            {
+                HVector<LogicalCore> allowed;
+                for (auto& core : s_LogicalCores)
+                    if (CPU_ISSET_S(core.Id, setSize, set))
+                        allowed.Add(core);
+
+                // Keep the full list if the mask doesn't line up with what was detected at all
+                if (!allowed.IsEmpty())
+                    s_LogicalCores = allowed;
+            }
+
+            CPU_FREE(set);
+        #endif
+    }
+
+    void CpuTopology::Finalize()
+    {
+        std::sort(s_LogicalCores.begin(), s_LogicalCores.end(), [](const LogicalCore& a, const LogicalCore& b)
+        {
+            return a.Id < b.Id;
+        });
+
+        std::unordered_set<u32> seenCores;
+        u32 maxId = 0;
+        s_NumaNodeCount = 1;
+        for (auto& core : s_LogicalCores)
+        {
+            core.IsPrimary = seenCores.insert(core.PhysicalCore).second;
+            maxId = std::max(maxId, core.Id);
+            s_NumaNodeCount = std::max(s_NumaNodeCount, core.NumaNode + 1);
+        }
+        s_PhysicalCoreCount = seenCores.size();
+
+        s_NodeOfCore.Resize(maxId + 1, false);
+        for (u32 i = 0; i <= maxId; i++)
+            s_NodeOfCore[i] = 0;
+        for (auto& core : s_LogicalCores)
+            s_NodeOfCore[core.Id] = core.NumaNode;
+    }
+
+    HVector<u32> CpuTopology::ParseCpuList(const HStringView8& list)
+    {
+        // Formatted like 0-3,8,10-11
+        HVector<u32> ids;
+        const char* str = list.Data();
+        const char* end = str + list.Count();
+        while (str < end)
+        {
+            char* next;
+            u32 first = static_cast<u32>(strtoul(str, &next, 10));
+            if (next == str) break;
+            u32 last = first;
+            if (next < end && *next == '-')
+            {
+                str = next + 1;
+                last = static_cast<u32>(strtoul(str, &next, 10));
+            }
+            for (u32 i = first; i <= last; i++)
+                ids.Add(i);
+
+            str = next;
+            while (str < end && (*str == ',' || *str == '\n' || *str == ' '))
+                str++;
+        }
+
+        return ids;
+    }
+
+    bool CpuTopology::ReadNumber(const std::string& path, u32& outValue)
+    {
+        std::ifstream file(path);
+        return static_cast<bool>(file >> outValue);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HString8.h"
+
+namespace Heart
+{
+    // Layout of the processors the engine is running on. Detected once on first use from
+    // sysfs (falling back to /proc/cpuinfo) on Linux and from the system on Windows. Other
+    // platforms report every logical processor as its own core on a single node. On Linux only
+    // the processors in the process' affinity mask are reported
+    class CpuTopology
+    {
+    public:
+        struct LogicalCore
+        {
+            // Processor index used by the OS
+            u32 Id;
+            // Shared by SMT siblings
+            u32 PhysicalCore;
+            u32 NumaNode;
+            // Whether this is the first hardware thread of its physical core
+            bool IsPrimary;
+        };
+
+    public:
+        static const HVector<LogicalCore>& GetLogicalCores();
+        static u32 GetPhysicalCoreCount();
+        static u32 GetNumaNodeCount();
+
+        // Logical core ids in the order threads should be placed on them: the primary thread of
+        // every physical core grouped by node, followed by the SMT siblings if requested. Keeping
+        // a pool packed onto as few nodes as possible avoids cross socket traffic
+        static HVector<u32> GetPreferredCores(bool includeSmtSiblings);
+
+        // Returns false if the platform does not support pinning or the call failed
+        static bool PinCurrentThread(u32 logicalCore);
+
+        static u32 GetNumaNode(u32 logicalCore);
+        static u32 GetCurrentNumaNode();
+
+    private:
+        static void Detect();
+        static bool DetectFromSysfs(const HStringView8& root);
+        static bool DetectFromCpuinfo(const HStringView8& path);
+        static void DetectFallback();
+        static void FilterToProcessAffinity();
+        static void Finalize();
+        static HVector<u32> ParseCpuList(const HStringView8& list);
+        static bool ReadNumber(const std::string& path, u32& outValue);
+
+    private:
+        inline static HVector<LogicalCore> s_LogicalCores;
+        // Indexed by OS processor id
+        inline static HVector<u32> s_NodeOfCore;
+        inline static u32 s_PhysicalCoreCount = 0;
+        inline static u32 s_NumaNodeCount = 0;
+        inline static std::once_flag s_DetectFlag;
+    };
+}
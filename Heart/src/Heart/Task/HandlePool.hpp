@@ -0,0 +1,125 @@
+#pragma once
+
+namespace Heart
+{
+    // Lock-free pool of T addressed by index that grows in fixed size segments so that
+    // existing entries never move. Public handles pack the slot index together with a
+    // generation that is bumped every time the slot is freed, so a stale handle can be
+    // detected instead of silently aliasing whatever reuses the slot
+    template <typename T>
+    class HandlePool
+    {
+    public:
+        HandlePool() = default;
+
+        ~HandlePool()
+        {
+            for (auto& segment : m_Segments)
+                delete[] segment.load(std::memory_order_relaxed);
+        }
+
+        HandlePool(const HandlePool&) = delete;
+        HandlePool& operator=(const HandlePool&) = delete;
+
+        // Returns the index of a free slot, allocating a new segment if necessary
+        u32 Allocate()
+        {
+            u64 head = m_FreeHead.load(std::memory_order_acquire);
+            while (GetHeadIndex(head) != InvalidIndex)
+            {
+                u32 index = GetHeadIndex(head);
+                u32 next = GetSlot(index).NextFree.load(std::memory_order_relaxed);
+                if (m_FreeHead.compare_exchange_weak(
+                    head, MakeHead(next, GetHeadTag(head) + 1),
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire
+                ))
+                    return index;
+            }
+
+            // Free list is empty so take a fresh slot
+            u32 index = m_NextFresh.fetch_add(1, std::memory_order_relaxed);
+            u32 segmentIndex = index / SegmentSize;
+            HE_ENGINE_ASSERT(segmentIndex < MaxSegments, "HandlePool exhausted");
+
+            auto& segment = m_Segments[segmentIndex];
+            if (!segment.load(std::memory_order_acquire))
+            {
+                // Another thread may be racing to create the same segment, in which case
+                // the loser throws theirs away
+                Slot* created = new Slot[SegmentSize];
+                Slot* expected = nullptr;
+                if (!segment.compare_exchange_strong(expected, created, std::memory_order_acq_rel))
+                    delete[] created;
+            }
+
+            return index;
+        }
+
+        // Invalidates all outstanding handles to the slot and makes it available for reuse
+        void Free(u32 index)
+        {
+            Slot& slot = GetSlot(index);
+            slot.Generation.fetch_add(1, std::memory_order_release);
+
+            u64 head = m_FreeHead.load(std::memory_order_relaxed);
+            do
+            {
+                slot.NextFree.store(GetHeadIndex(head), std::memory_order_relaxed);
+            } while (!m_FreeHead.compare_exchange_weak(
+                head, MakeHead(index, GetHeadTag(head) + 1),
+                std::memory_order_release,
+                std::memory_order_relaxed
+            ));
+        }
+
+        inline u64 GetHandle(u32 index) const
+        {
+            return (static_cast<u64>(GetSlot(index).Generation.load(std::memory_order_acquire)) << 32) | index;
+        }
+
+        // Whether the handle still refers to the allocation it was created from
+        inline bool IsCurrent(u64 handle) const
+        {
+            u32 index = GetIndex(handle);
+            if (index >= m_NextFresh.load(std::memory_order_acquire)) return false;
+            return GetSlot(index).Generation.load(std::memory_order_acquire) == GetGeneration(handle);
+        }
+
+        inline u32 GetCapacity() const { return m_NextFresh.load(std::memory_order_relaxed); }
+        inline T& Get(u32 index) const { return GetSlot(index).Data; }
+        inline T& operator[](u32 index) const { return Get(index); }
+
+        inline static constexpr u32 GetIndex(u64 handle) { return static_cast<u32>(handle); }
+        inline static constexpr u32 GetGeneration(u64 handle) { return static_cast<u32>(handle >> 32); }
+
+        inline static constexpr u32 SegmentSize = 1024;
+        inline static constexpr u32 MaxSegments = 4096;
+
+    private:
+        struct Slot
+        {
+            T Data;
+            std::atomic<u32> Generation = 0;
+            std::atomic<u32> NextFree = InvalidIndex;
+        };
+
+    private:
+        inline Slot& GetSlot(u32 index) const
+        {
+            return m_Segments[index / SegmentSize].load(std::memory_order_acquire)[index % SegmentSize];
+        }
+
+        // The free list head carries a tag alongside the index to avoid ABA
+        inline static constexpr u64 MakeHead(u32 index, u32 tag) { return (static_cast<u64>(tag) << 32) | index; }
+        inline static constexpr u32 GetHeadIndex(u64 head) { return static_cast<u32>(head); }
+        inline static constexpr u32 GetHeadTag(u64 head) { return static_cast<u32>(head >> 32); }
+
+        inline static constexpr u32 InvalidIndex = std::numeric_limits<u32>::max();
+
+    private:
+        std::atomic<Slot*> m_Segments[MaxSegments] = {};
+        std::atomic<u64> m_FreeHead = MakeHead(InvalidIndex, 0);
+        std::atomic<u32> m_NextFresh = 0;
+    };
+}
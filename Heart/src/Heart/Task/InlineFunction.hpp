@@ -0,0 +1,235 @@
+#pragma once
+
+namespace Heart
+{
+    // Recycles the out of line storage used by InlineFunction for callables that do not fit
+    // inline. Blocks are bucketed into power of two size classes and are never handed back
+    // to the system, so once warmed up scheduling large closures does not touch the heap
+    class ClosureArena
+    {
+    public:
+        static void* Allocate(size_t size)
+        {
+            u32 sizeClass = GetSizeClass(size);
+            if (sizeClass >= SizeClassCount)
+            {
+                s_HeapAllocations++;
+                return ::operator new(size);
+            }
+
+            auto& freeList = s_FreeLists[sizeClass];
+            freeList.Mutex.lock();
+            void* block = freeList.Head;
+            if (block)
+                freeList.Head = *static_cast<void**>(block);
+            freeList.Mutex.unlock();
+
+            if (!block)
+            {
+                s_HeapAllocations++;
+                block = ::operator new(MinBlockSize << sizeClass);
+            }
+
+            return block;
+        }
+
+        static void Free(void* block, size_t size)
+        {
+            u32 sizeClass = GetSizeClass(size);
+            if (sizeClass >= SizeClassCount)
+            {
+                ::operator delete(block);
+                return;
+            }
+
+            auto& freeList = s_FreeLists[sizeClass];
+            freeList.Mutex.lock();
+            *static_cast<void**>(block) = freeList.Head;
+            freeList.Head = block;
+            freeList.Mutex.unlock();
+        }
+
+        // Number of times the arena has had to fall back to the system allocator
+        inline static u64 GetHeapAllocationCount() { return s_HeapAllocations.load(std::memory_order_relaxed); }
+
+        inline static constexpr size_t MinBlockSize = 64;
+        inline static constexpr u32 SizeClassCount = 7; // Up to 4kb
+
+    private:
+        struct FreeList
+        {
+            std::mutex Mutex;
+            void* Head;
+        };
+
+    private:
+        static u32 GetSizeClass(size_t size)
+        {
+            u32 sizeClass = 0;
+            while ((MinBlockSize << sizeClass) < size)
+                sizeClass++;
+            return sizeClass;
+        }
+
+    private:
+        inline static FreeList s_FreeLists[SizeClassCount];
+        inline static std::atomic<u64> s_HeapAllocations = 0;
+    };
+
+    // Move-only replacement for std::function that stores callables of up to InlineSize
+    // bytes directly inside of itself. Larger callables are placed in the ClosureArena
+    template <typename Signature, size_t InlineSize = 64>
+    class InlineFunction;
+
+    template <typename R, typename... Args, size_t InlineSize>
+    class InlineFunction<R(Args...), InlineSize>
+    {
+    public:
+        InlineFunction() = default;
+        InlineFunction(std::nullptr_t) {}
+
+        template <
+            typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, InlineFunction> &&
+                std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+            >
+        >
+        InlineFunction(F&& func)
+        {
+            Assign(std::forward<F>(func));
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        ~InlineFunction()
+        {
+            Reset();
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this == &other) return *this;
+            Reset();
+            MoveFrom(other);
+            return *this;
+        }
+
+        InlineFunction& operator=(std::nullptr_t)
+        {
+            Reset();
+            return *this;
+        }
+
+        // Throws like std::function when empty
+        inline R operator()(Args... args) const
+        {
+            if (!m_Ops)
+                throw std::bad_function_call();
+            return m_Ops->Invoke(m_Object, std::forward<Args>(args)...);
+        }
+
+        inline explicit operator bool() const { return m_Ops != nullptr; }
+        inline bool IsInline() const { return m_Object == m_Storage; }
+
+        inline static constexpr size_t GetInlineSize() { return InlineSize; }
+
+    private:
+        struct Ops
+        {
+            R (*Invoke)(void*, Args&&...);
+            void (*Relocate)(void*, void*);
+            void (*Destroy)(void*);
+            size_t Size;
+        };
+
+        template <typename F>
+        struct OpsFor
+        {
+            static R Invoke(void* func, Args&&... args)
+            {
+                return (*static_cast<F*>(func))(std::forward<Args>(args)...);
+            }
+
+            static void Relocate(void* dst, void* src)
+            {
+                F* srcFunc = static_cast<F*>(src);
+                new (dst) F(std::move(*srcFunc));
+                srcFunc->~F();
+            }
+
+            static void Destroy(void* func)
+            {
+                static_cast<F*>(func)->~F();
+            }
+
+            inline static constexpr Ops Table = { &Invoke, &Relocate, &Destroy, sizeof(F) };
+        };
+
+        template <typename F>
+        inline static constexpr bool FitsInline =
+            sizeof(F) <= InlineSize &&
+            alignof(F) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<F>;
+
+    private:
+        template <typename F>
+        void Assign(F&& func)
+        {
+            using Func = std::decay_t<F>;
+            static_assert(alignof(Func) <= alignof(std::max_align_t), "InlineFunction does not support over-aligned callables");
+
+            // Keep null function pointers and empty std::functions empty
+            if constexpr (std::is_pointer_v<Func> || std::is_same_v<Func, std::function<R(Args...)>>)
+                if (!func) return;
+
+            if constexpr (FitsInline<Func>)
+                m_Object = m_Storage;
+            else
+                m_Object = ClosureArena::Allocate(sizeof(Func));
+
+            new (m_Object) Func(std::forward<F>(func));
+            m_Ops = &OpsFor<Func>::Table;
+        }
+
+        void MoveFrom(InlineFunction& other)
+        {
+            if (!other.m_Ops) return;
+
+            if (other.IsInline())
+            {
+                other.m_Ops->Relocate(m_Storage, other.m_Storage);
+                m_Object = m_Storage;
+            }
+            else
+                m_Object = other.m_Object;
+            m_Ops = other.m_Ops;
+
+            other.m_Ops = nullptr;
+            other.m_Object = nullptr;
+        }
+
+        void Reset()
+        {
+            if (!m_Ops) return;
+
+            m_Ops->Destroy(m_Object);
+            if (!IsInline())
+                ClosureArena::Free(m_Object, m_Ops->Size);
+
+            m_Ops = nullptr;
+            m_Object = nullptr;
+        }
+
+    private:
+        const Ops* m_Ops = nullptr;
+        void* m_Object = nullptr;
+        alignas(std::max_align_t) u8 m_Storage[InlineSize];
+    };
+}
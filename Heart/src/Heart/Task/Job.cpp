@@ -10,7 +10,7 @@ namespace Heart
         Copy(other);
     }
 
-    Job::Job(u32 handle, bool incref)
+    Job::Job(u64 handle, bool incref)
         : m_Handle(handle)
     {
         if (m_Handle == InvalidHandle) return;
@@ -31,6 +31,8 @@ namespace Heart
 
     void Job::Copy(const Job& other)
     {
+        if (&other == this) return;
+
         if (m_Handle != InvalidHandle)
             JobManager::DecrementRefCount(m_Handle);
         m_Handle = other.m_Handle;
@@ -9,22 +9,23 @@ namespace Heart
     public:
         Job() = default;
         Job(const Job& other);
-        Job(u32 handle, bool incref = true);
+        Job(u64 handle, bool incref = true);
         ~Job();
 
         bool Wait(u32 timeout = 0) const;
         
-        inline u32 GetHandle() const { return m_Handle; }
+        inline u64 GetHandle() const { return m_Handle; }
         
         inline void operator=(const Job& other) { Copy(other); }
         
-        inline static constexpr u32 InvalidHandle = std::numeric_limits<u32>::max();
+        // Packs the pool slot index with the generation of the slot when it was allocated
+        inline static constexpr u64 InvalidHandle = std::numeric_limits<u64>::max();
 
     private:
         void Copy(const Job& other);
         
     private:
-        u32 m_Handle = InvalidHandle;
+        u64 m_Handle = InvalidHandle;
     };
 
 }
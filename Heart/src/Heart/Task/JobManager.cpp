@@ -2,46 +2,41 @@
 #include "JobManager.h"
 
 #include "Heart/Core/Timing.h"
+#include "Heart/Task/TaskManager.h"
 
 namespace Heart
 {
-    void JobManager::Initialize(u32 numWorkers)
+    void JobManager::Initialize()
     {
-        if (numWorkers == 0)
+        s_SingleThreaded = TaskManager::GetWorkerCount() == 0;
+        s_Initialized = true;
+
+        s_PartitionWeights.Clear();
+        s_NodePartitions.Clear();
+        u32 partitionCount = 0;
+        for (u32 i = 0; i < TaskManager::GetWorkerCount(); i++)
         {
-            s_SingleThreaded = true;
-            s_Initialized = true;
+            u32 node = TaskManager::GetWorkerNumaNode(i);
+            while (s_NodePartitions.Count() <= node)
+                s_NodePartitions.Add(InvalidPartition);
 
-            return;
+            if (s_NodePartitions[node] == InvalidPartition)
+            {
+                // Nodes past the limit share a partition with an earlier one
+                s_NodePartitions[node] = partitionCount++ % MaxPartitions;
+                if (s_PartitionWeights.Count() < MaxPartitions)
+                    s_PartitionWeights.Add(0);
+            }
+            s_PartitionWeights[s_NodePartitions[node]]++;
         }
-
-        // Populate initial data to prevent resizing
-        s_JobList.Resize(5000);
-        s_HandleFreeList.Reserve(s_JobList.Count());
-        for (u32 i = 0; i < s_JobList.Count(); i++)
-            s_HandleFreeList.Add(i);
-            
-        s_Initialized = true;
-
-        s_ExecuteQueues.Resize(numWorkers);
-        for (u32 i = 0; i < numWorkers; i++)
-            s_WorkerThreads.AddInPlace(&JobManager::ProcessQueue, i);
     }
 
     void JobManager::Shutdown()
     {
         s_Initialized = false;
-        
-        // Wake all worker threads
-        for (auto& queue : s_ExecuteQueues)
-            queue.QueueCV.notify_all();
-        
-        // Now wait for completion
-        for (auto& thread : s_WorkerThreads)
-            thread.join();
     }
 
-    Job JobManager::Schedule(size_t count, std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check)
+    Job JobManager::Schedule(size_t count, JobFunction&& job, std::function<bool(size_t)>&& check)
     {
         HE_PROFILE_FUNCTION();
 
@@ -52,61 +47,102 @@ namespace Heart
             indices.AddInPlace(i);
         }
 
-        u32 handle = ScheduleInternal(indices, std::move(job), std::move(check));
+        u32 indexCount = indices.Count();
+        u64 handle = ScheduleInternal(0, indexCount, 1, std::move(indices), std::move(job));
+        return Job(handle, false);
+    }
+
+    Job JobManager::ParallelFor(size_t begin, size_t end, size_t grain, JobFunction&& job)
+    {
+        HE_PROFILE_FUNCTION();
+
+        u64 handle = ScheduleInternal(begin, std::max(begin, end), std::max(grain, (size_t)1), HVector<size_t>(), std::move(job));
         return Job(handle, false);
     }
 
-    u32 JobManager::ScheduleInternal(const HVector<size_t>& indices, std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check)
+    u64 JobManager::ScheduleInternal(size_t begin, size_t end, size_t grain, HVector<size_t>&& indices, JobFunction&& job)
     {
+        bool useIndices = !indices.IsEmpty();
+        size_t count = end - begin;
+
         if (s_SingleThreaded)
         {
-            for (size_t i = 0; i < indices.Count(); i++)
-                job(indices[i]);
+            for (size_t i = begin; i < end; i++)
+                job(useIndices ? indices[i] : i);
             
             return 0;
         }
 
+        // Never split below the grain, but otherwise cut enough chunks that workers which
+        // finish early can keep pulling from the range
+        u32 workerCount = TaskManager::GetWorkerCount();
+        size_t maxChunks = (size_t)workerCount * ChunksPerWorker;
+        size_t chunkCount = std::clamp(count / grain, (size_t)1, maxChunks);
+        size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        u32 participants = (u32)std::min((size_t)workerCount, chunkCount);
+
         u32 handle = CreateJob();
 
         JobData& data = s_JobList[handle];
         data.Mutex.lock();
-        data.Complete = indices.Count() == 0;
-        data.Remaining = indices.Count();
-        data.RefCount = indices.Count() == 0 ? 1 : 2;
+        data.Complete = count == 0;
+        data.Remaining = count;
+        // One reference for the returned job and one for each queued participant
+        data.RefCount = count == 0 ? 1 : 1 + participants;
         data.Job = std::move(job);
-        data.Mutex.unlock();
-
-        if (indices.IsEmpty())
-            return handle;
+        // Share the list rather than copying it. The caller's reference is dropped right away so
+        // that the job holds the only one
+        data.Indices.ShallowCopy(indices);
+        indices.Clear(true);
+        data.ChunkSize = chunkSize;
 
-        u32 countPerThread = indices.Count() / s_ExecuteQueues.Count();
-        for (u32 i = 0; i < s_ExecuteQueues.Count(); i++)
+        // Slices are proportional to the number of workers on each node
+        u32 totalWeight = workerCount;
+        data.PartitionCount = s_PartitionWeights.Count();
+        size_t partitionBegin = begin;
+        u32 weightSoFar = 0;
+        for (u32 i = 0; i < data.PartitionCount; i++)
         {
-            auto& queue = s_ExecuteQueues[i];
-            queue.Mutex.lock();
-            auto& entry = queue.Queue.emplace();
-            entry.Handle = handle;
-            entry.Indices.CopyFrom(
-                indices.begin() + i * countPerThread,
-                i == s_ExecuteQueues.Count() - 1
-                    ? indices.end()
-                    : indices.begin() + (i + 1) * countPerThread
-            );
-            queue.Mutex.unlock();
-            queue.QueueCV.notify_all();
+            weightSoFar += s_PartitionWeights[i];
+            size_t partitionEnd = i == data.PartitionCount - 1 ? end : begin + count * weightSoFar / totalWeight;
+            data.Partitions[i].Cursor = partitionBegin;
+            data.Partitions[i].End = partitionEnd;
+            partitionBegin = partitionEnd;
         }
+        data.BusyTotal = 0;
+        data.BusyMax = 0;
+        data.Failed = false;
+        data.Exception = nullptr;
+        data.MaxParticipants = participants;
+        data.Imbalance = 1.f;
+        data.Mutex.unlock();
+
+        u64 publicHandle = s_JobList.GetHandle(handle);
+        if (count == 0)
+            return publicHandle;
+
+        // Each participant is a task on the shared worker pool. Participants queued from a worker
+        // land on its own deque and get stolen by whichever workers are idle
+        for (u32 i = 0; i < participants; i++)
+            TaskManager::Schedule([handle](){ ExecuteJob(handle); }, Task::Priority::High, "Job");
 
-        return handle;
+        return publicHandle;
     }
 
     bool JobManager::Wait(const Job& job, u32 timeout)
     {
         if (job.GetHandle() == Job::InvalidHandle) return false;
         if (s_SingleThreaded) return true;
+        if (!s_JobList.IsCurrent(job.GetHandle())) return true;
 
         HE_PROFILE_FUNCTION();
         
-        auto& data = s_JobList[job.GetHandle()];
+        // Work on the job's remaining chunks ourselves rather than sitting idle. Once the
+        // cursor is exhausted all that is left is in flight on the workers
+        u32 handle = HandlePool<JobData>::GetIndex(job.GetHandle());
+        ExecuteChunks(handle);
+
+        auto& data = s_JobList[handle];
         std::unique_lock<std::mutex> lock(data.Mutex);
         bool complete = true;
         if (timeout)
@@ -119,89 +155,155 @@ namespace Heart
         }
         else
             data.CompletionCV.wait(lock, [&data]{ return data.Complete; });
+
+        std::exception_ptr exception = complete ? data.Exception : nullptr;
+        lock.unlock();
+        if (exception)
+            std::rethrow_exception(exception);
         
         return complete;
     }
-        static void ScheduleInternal(std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check);
+
+    float JobManager::GetImbalance(const Job& job)
+    {
+        if (job.GetHandle() == Job::InvalidHandle) return 1.f;
+        if (s_SingleThreaded) return 1.f;
+        if (!s_JobList.IsCurrent(job.GetHandle())) return 1.f;
+
+        auto& data = s_JobList[HandlePool<JobData>::GetIndex(job.GetHandle())];
+        std::lock_guard lock(data.Mutex);
+        return data.Imbalance;
+    }
 
     u32 JobManager::CreateJob()
     {
-        s_FreeListMutex.lock();
-        HE_ENGINE_ASSERT(s_HandleFreeList.Count() != 0, "Scheduled too many jobs!");
-        u32 handle = s_HandleFreeList.Back();
-        s_HandleFreeList.Pop();
-        s_FreeListMutex.unlock();
-        
-        return handle;
+        return s_JobList.Allocate();
     }
 
-    void JobManager::IncrementRefCount(u32 handle)
+    void JobManager::IncrementRefCount(u64 handle)
     {
         if (!s_Initialized || s_SingleThreaded) return;
+        HE_ENGINE_ASSERT(s_JobList.IsCurrent(handle), "Referencing a stale job handle");
 
-        s_JobList[handle].RefCount++;
+        s_JobList[HandlePool<JobData>::GetIndex(handle)].RefCount++;
     }
 
-    void JobManager::DecrementRefCount(u32 handle)
+    void JobManager::DecrementRefCount(u64 handle)
     {
         if (!s_Initialized || s_SingleThreaded) return;
+        HE_ENGINE_ASSERT(s_JobList.IsCurrent(handle), "Releasing a stale job handle");
 
+        ReleaseJob(HandlePool<JobData>::GetIndex(handle));
+    }
+
+    void JobManager::ReleaseJob(u32 handle)
+    {
         auto& data = s_JobList[handle];
         if (--data.RefCount == 0)
         {
             // Clear func to potentially free resources
             data.Mutex.lock();
             data.Job = nullptr;
+            data.Indices.Clear(true);
+            data.Exception = nullptr;
             data.Mutex.unlock();
 
-            s_FreeListMutex.lock();
-            s_HandleFreeList.Add(handle);
-            s_FreeListMutex.unlock();
+            s_JobList.Free(handle);
         }
     }
 
-    void JobManager::ProcessQueue(u32 workerIndex)
+    void JobManager::ExecuteJob(u32 handle)
+    {
+        ExecuteChunks(handle);
+
+        // Drop the reference held by this participant
+        ReleaseJob(handle);
+    }
+
+    void JobManager::ExecuteChunks(u32 handle)
     {
-        HE_PROFILE_THREAD("Job Thread");
+        auto& data = s_JobList[handle];
 
-        const auto pred = [workerIndex]{ return !s_ExecuteQueues[workerIndex].Queue.empty() || !s_Initialized; };
+        // Start with our own node's slice before helping with the others
+        u32 node = TaskManager::GetCurrentNumaNode();
+        u32 home = node < s_NodePartitions.Count() && s_NodePartitions[node] != InvalidPartition ? s_NodePartitions[node] : 0;
 
-        auto& queue = s_ExecuteQueues[workerIndex];
-        std::unique_lock lock(queue.Mutex);
-        while (s_Initialized)
+        u64 busy = 0;
+        for (u32 i = 0; i < data.PartitionCount; i++)
+            if (ExecutePartition(handle, data.Partitions[(home + i) % data.PartitionCount], busy))
+                return;
+    }
+
+    bool JobManager::ExecutePartition(u32 handle, Partition& partition, u64& busy)
+    {
+        auto& data = s_JobList[handle];
+
+        while (true)
         {
-            queue.QueueCV.wait(lock, pred);
-            
-            if (!s_Initialized) break;
-            
-            auto executeData = std::move(queue.Queue.front());
-            queue.Queue.pop();
-            lock.unlock();
-            
-            auto& data = s_JobList[executeData.Handle];
+            size_t begin = partition.Cursor.fetch_add(data.ChunkSize, std::memory_order_relaxed);
+            if (begin >= partition.End) return false;
+            size_t end = std::min(begin + data.ChunkSize, partition.End);
 
-            // Lock and unlock the mutex to ensure job data has been written
-            // TODO: this is technically not good enough because in theory this lock could get scheduled
-            // first by the OS. However, this seems to be good enough for now because there is still
-            // a decent amount of delay between this lock and the initial lock
-            data.Mutex.lock();
-            data.Mutex.unlock();
+            // A throwing chunk still counts as executed, otherwise the job would never complete
+            // and its waiters would block forever
+            auto start = std::chrono::steady_clock::now();
+            if (!data.Failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    if (data.Indices.IsEmpty())
+                    {
+                        for (size_t i = begin; i < end; i++)
+                            data.Job(i);
+                    }
+                    else
+                    {
+                        for (size_t i = begin; i < end; i++)
+                            data.Job(data.Indices[i]);
+                    }
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(data.Mutex);
+                    if (!data.Exception)
+                        data.Exception = std::current_exception();
+                    data.Failed = true;
+                }
+            }
+            u64 elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
 
-            for (size_t val : executeData.Indices)
-                data.Job(val);
-                
-            // Decrement job completion count
-            if (data.Remaining.fetch_sub(executeData.Indices.Count()) == executeData.Indices.Count())
+            // Stats are updated before the chunk is counted as finished so that they are final
+            // by the time the job completes
+            busy += elapsed;
+            data.BusyTotal.fetch_add(elapsed, std::memory_order_relaxed);
+            u64 prevMax = data.BusyMax.load(std::memory_order_relaxed);
+            while (prevMax < busy && !data.BusyMax.compare_exchange_weak(prevMax, busy, std::memory_order_relaxed));
+
+            size_t executed = end - begin;
+            if (data.Remaining.fetch_sub(executed, std::memory_order_acq_rel) == executed)
             {
-                data.Mutex.lock();
-                data.Complete = true;
-                data.Mutex.unlock();
-                DecrementRefCount(executeData.Handle);
-                data.CompletionCV.notify_all();
+                CompleteJob(handle);
+                return true;
             }
-            
-            // Relock lock before next iteration (required by wait())
-            lock.lock();
         }
     }
+
+    void JobManager::CompleteJob(u32 handle)
+    {
+        auto& data = s_JobList[handle];
+
+        float imbalance = 1.f;
+        u64 busyTotal = data.BusyTotal.load(std::memory_order_relaxed);
+        if (busyTotal > 0)
+            imbalance = (float)data.BusyMax.load(std::memory_order_relaxed) * data.MaxParticipants / busyTotal;
+
+        float average = s_AverageImbalance.load(std::memory_order_relaxed);
+        s_AverageImbalance.store(average + (imbalance - average) * ImbalanceSmoothing, std::memory_order_relaxed);
+
+        data.Mutex.lock();
+        data.Imbalance = imbalance;
+        data.Complete = true;
+        data.Mutex.unlock();
+        data.CompletionCV.notify_all();
+    }
 }
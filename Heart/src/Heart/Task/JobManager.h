@@ -3,61 +3,126 @@
 #include "Heart/Container/HVector.hpp"
 #include "Heart/Container/HString8.h"
 #include "Heart/Task/Job.h"
+#include "Heart/Task/HandlePool.hpp"
+#include "Heart/Task/InlineFunction.hpp"
 
 namespace Heart
 {
+    using JobFunction = InlineFunction<void(size_t), 64>;
+
+    // Jobs run on the TaskManager's workers, so TaskManager must be initialized first
     class JobManager
     {
     public:
-        static void Initialize(u32 numWorkers);
+        static void Initialize();
         static void Shutdown();
         
-        static Job Schedule(size_t count, std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check = [](size_t index){ return true; });
+        static Job Schedule(size_t count, JobFunction&& job, std::function<bool(size_t)>&& check = [](size_t index){ return true; });
         
         template<typename Iter>
-        static Job ScheduleIter(Iter begin, Iter end, std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check = [](size_t index){ return true; });
+        static Job ScheduleIter(Iter begin, Iter end, JobFunction&& job, std::function<bool(size_t)>&& check = [](size_t index){ return true; });
+
+        // Runs job for every index in [begin, end) without materializing an index list. The range is
+        // split into chunks of at least grain indices, sized so that every worker gets a few of them
+        static Job ParallelFor(size_t begin, size_t end, size_t grain, JobFunction&& job);
+        
+        // Combines map(i) for every index in [begin, end) and returns the result. The range is cut into
+        // blocks that depend only on its size and the grain, and block results are combined from left
+        // to right, so the result is reproducible no matter how many workers took part
+        template<typename T, typename Map, typename Combine = std::plus<T>>
+        static T ParallelReduce(size_t begin, size_t end, size_t grain, const T& identity, Map&& map, Combine&& combine = Combine());
+
+        // Calls output(i, prefix) where prefix combines input(j) for every j < i, and returns the combined
+        // total. Input is called twice for every index, so it should be cheap (i.e. reading a field)
+        template<typename T, typename Input, typename Output, typename Combine = std::plus<T>>
+        static T ParallelExclusiveScan(size_t count, size_t grain, const T& identity, Input&& input, Output&& output, Combine&& combine = Combine());
+
+        // Calls output(i, slot) for every index where keep(i) is true, with slots packed from zero in index
+        // order, and returns the number kept. Keep is only called once for every index
+        template<typename Predicate, typename Output>
+        static size_t ParallelCompact(size_t count, size_t grain, Predicate&& keep, Output&& output);
         
+        // The calling thread runs any chunks of the job that have not been claimed yet before blocking.
+        // Once the job completes, the first exception thrown by its function is rethrown here
         static bool Wait(const Job& job, u32 timeout); // milliseconds
+
+        // Ratio between the busiest worker's time spent on a completed job and an even split of the
+        // total across the workers that could have taken part. 1 is perfectly balanced
+        static float GetImbalance(const Job& job);
+
+        // Running average of GetImbalance over recently completed jobs
+        inline static float GetAverageImbalance() { return s_AverageImbalance.load(std::memory_order_relaxed); }
     
     private:
+        inline static constexpr u32 MaxPartitions = 8;
+        inline static constexpr u32 InvalidPartition = std::numeric_limits<u32>::max();
+
+        // Contiguous slice of a job's range that belongs to one NUMA node
+        struct Partition
+        {
+            // Kept on separate cache lines since each is hammered by a different node
+            alignas(64) std::atomic<size_t> Cursor;
+            size_t End;
+        };
+
         struct JobData
         {
             bool Complete;
-            std::function<void(size_t)> Job = nullptr;
+            JobFunction Job = nullptr;
+            // When populated, the range indexes into this list rather than being passed directly
+            HVector<size_t> Indices;
+            size_t ChunkSize;
+            // Workers claim chunks from their node's cursor until it passes the end, then move
+            // on to the other partitions so that whoever finishes early keeps pulling work
+            // instead of idling. The same slice lands on the same node every time a range is
+            // processed, which keeps the memory it first touched local
+            Partition Partitions[MaxPartitions];
+            u32 PartitionCount;
             std::atomic<u32> RefCount;
-            std::atomic<u32> Remaining;
+            std::atomic<size_t> Remaining;
+            std::atomic<u64> BusyTotal;
+            // Chunks claimed after a failure are counted without being run
+            std::atomic<bool> Failed;
+            std::exception_ptr Exception;
+            std::atomic<u64> BusyMax;
+            u32 MaxParticipants;
+            float Imbalance;
             std::mutex Mutex;
             std::condition_variable CompletionCV;
         };
         
-        struct ExecutionData
-        {
-            u32 Handle;
-            HVector<size_t> Indices;
-        };
-        
-        struct WorkerQueue
-        {
-            std::queue<ExecutionData> Queue;
-            std::mutex Mutex;
-            std::condition_variable QueueCV;
-        };
-        
     private:
-        static u32 ScheduleInternal(const HVector<size_t>& indices, std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check);
+        static u64 ScheduleInternal(size_t begin, size_t end, size_t grain, HVector<size_t>&& indices, JobFunction&& job);
         static u32 CreateJob();
-        static void IncrementRefCount(u32 handle);
-        static void DecrementRefCount(u32 handle);
-        static void ProcessQueue(u32 workerIndex);
+        static void IncrementRefCount(u64 handle);
+        static void DecrementRefCount(u64 handle);
+        static void ReleaseJob(u32 handle);
+        static void ExecuteJob(u32 handle);
+        static void ExecuteChunks(u32 handle);
+        static void CompleteJob(u32 handle);
+        static bool ExecutePartition(u32 handle, Partition& partition, u64& busy);
+
+        // Splits count into at most MaxBlocks blocks of at least grain indices
+        inline static size_t GetBlockSize(size_t count, size_t grain)
+        {
+            size_t blockCount = std::clamp(count / std::max(grain, (size_t)1), (size_t)1, MaxBlocks);
+            return std::max((count + blockCount - 1) / blockCount, (size_t)1);
+        }
         
     private:
-        inline static HVector<WorkerQueue> s_ExecuteQueues;
-        inline static HVector<u32> s_HandleFreeList;
-        inline static HVector<JobData> s_JobList;
-        inline static HVector<std::thread> s_WorkerThreads;
-        
-        inline static std::mutex s_FreeListMutex;
+        inline static HandlePool<JobData> s_JobList;
         
+        inline static std::atomic<float> s_AverageImbalance = 1.f;
+
+        // Workers per partition and the partition each node maps to, built from where the
+        // TaskManager pinned its workers. There is a single partition when workers are not pinned
+        inline static HVector<u32> s_PartitionWeights;
+        inline static HVector<u32> s_NodePartitions;
+
+        inline static constexpr u32 ChunksPerWorker = 8;
+        inline static constexpr size_t MaxBlocks = 256;
+        inline static constexpr float ImbalanceSmoothing = 0.05f;
+
         inline static bool s_Initialized = false;
         inline static bool s_SingleThreaded = false;
         
@@ -65,7 +130,7 @@ namespace Heart
     };
 
     template<typename Iter>
-    Job JobManager::ScheduleIter(Iter begin, Iter end, std::function<void(size_t)>&& job, std::function<bool(size_t)>&& check)
+    Job JobManager::ScheduleIter(Iter begin, Iter end, JobFunction&& job, std::function<bool(size_t)>&& check)
     {
         HE_PROFILE_FUNCTION();
 
@@ -77,8 +142,135 @@ namespace Heart
             indices.AddInPlace((size_t)*begin);
         }
 
-        u32 handle = ScheduleInternal(indices, std::move(job), std::move(check));
+        u32 count = indices.Count();
+        u64 handle = ScheduleInternal(0, count, 1, std::move(indices), std::move(job));
         return Job(handle, false);
     }
 
+    template<typename T, typename Map, typename Combine>
+    T JobManager::ParallelReduce(size_t begin, size_t end, size_t grain, const T& identity, Map&& map, Combine&& combine)
+    {
+        HE_PROFILE_FUNCTION();
+
+        size_t count = end > begin ? end - begin : 0;
+        if (count == 0) return identity;
+
+        size_t blockSize = GetBlockSize(count, grain);
+        size_t blockCount = (count + blockSize - 1) / blockSize;
+        // Every partial starts out constructed since T is not required to be default constructible
+        HVector<T> partials;
+        partials.Resize((u32)blockCount, false);
+        for (auto& partial : partials)
+            new (&partial) T(identity);
+
+        ParallelFor(0, blockCount, 1, [&](size_t block)
+        {
+            size_t blockBegin = begin + block * blockSize;
+            size_t blockEnd = std::min(blockBegin + blockSize, end);
+            T accumulator = identity;
+            for (size_t i = blockBegin; i < blockEnd; i++)
+                accumulator = combine(accumulator, map(i));
+            partials[block] = std::move(accumulator);
+        }).Wait();
+
+        T result = identity;
+        for (auto& partial : partials)
+            result = combine(result, partial);
+        return result;
+    }
+
+    template<typename T, typename Input, typename Output, typename Combine>
+    T JobManager::ParallelExclusiveScan(size_t count, size_t grain, const T& identity, Input&& input, Output&& output, Combine&& combine)
+    {
+        HE_PROFILE_FUNCTION();
+
+        if (count == 0) return identity;
+
+        // Reduce each block, scan the block totals, then rescan each block starting from its offset
+        size_t blockSize = GetBlockSize(count, grain);
+        size_t blockCount = (count + blockSize - 1) / blockSize;
+        HVector<T> offsets;
+        offsets.Resize((u32)blockCount, false);
+        for (auto& offset : offsets)
+            new (&offset) T(identity);
+
+        ParallelFor(0, blockCount, 1, [&](size_t block)
+        {
+            size_t blockEnd = std::min((block + 1) * blockSize, count);
+            T accumulator = identity;
+            for (size_t i = block * blockSize; i < blockEnd; i++)
+                accumulator = combine(accumulator, input(i));
+            offsets[block] = std::move(accumulator);
+        }).Wait();
+
+        T total = identity;
+        for (auto& offset : offsets)
+        {
+            T blockTotal = std::move(offset);
+            offset = total;
+            total = combine(total, blockTotal);
+        }
+
+        ParallelFor(0, blockCount, 1, [&](size_t block)
+        {
+            size_t blockEnd = std::min((block + 1) * blockSize, count);
+            T accumulator = offsets[block];
+            for (size_t i = block * blockSize; i < blockEnd; i++)
+            {
+                T value = input(i);
+                output(i, static_cast<const T&>(accumulator));
+                accumulator = combine(accumulator, value);
+            }
+        }).Wait();
+
+        return total;
+    }
+
+    template<typename Predicate, typename Output>
+    size_t JobManager::ParallelCompact(size_t count, size_t grain, Predicate&& keep, Output&& output)
+    {
+        HE_PROFILE_FUNCTION();
+
+        if (count == 0) return 0;
+
+        // Results of the predicate are kept so that it does not need to run again when placing
+        size_t blockSize = GetBlockSize(count, grain);
+        size_t blockCount = (count + blockSize - 1) / blockSize;
+        HVector<u8> kept;
+        HVector<size_t> offsets;
+        kept.Resize((u32)count, false);
+        offsets.Resize((u32)blockCount, false);
+
+        ParallelFor(0, blockCount, 1, [&](size_t block)
+        {
+            size_t blockEnd = std::min((block + 1) * blockSize, count);
+            size_t keptCount = 0;
+            for (size_t i = block * blockSize; i < blockEnd; i++)
+            {
+                kept[i] = keep(i) ? 1 : 0;
+                keptCount += kept[i];
+            }
+            offsets[block] = keptCount;
+        }).Wait();
+
+        size_t total = 0;
+        for (size_t& offset : offsets)
+        {
+            size_t blockTotal = offset;
+            offset = total;
+            total += blockTotal;
+        }
+
+        ParallelFor(0, blockCount, 1, [&](size_t block)
+        {
+            size_t blockEnd = std::min((block + 1) * blockSize, count);
+            size_t slot = offsets[block];
+            for (size_t i = block * blockSize; i < blockEnd; i++)
+                if (kept[i])
+                    output(i, slot++);
+        }).Wait();
+
+        return total;
+    }
+
 }
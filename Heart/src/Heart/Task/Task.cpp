@@ -10,7 +10,7 @@ namespace Heart
         Copy(other);
     }
 
-    Task::Task(u32 handle, bool incref)
+    Task::Task(u64 handle, bool incref)
         : m_Handle(handle)
     {
         if (m_Handle == InvalidHandle) return;
@@ -29,8 +29,33 @@ namespace Heart
         return TaskManager::Wait(*this, timeout);
     }
 
+    void Task::Cancel() const
+    {
+        TaskManager::Cancel(*this);
+    }
+
+    Task::Status Task::GetStatus() const
+    {
+        return TaskManager::GetStatus(*this);
+    }
+
+    std::exception_ptr Task::GetException() const
+    {
+        return TaskManager::GetException(*this);
+    }
+
+    void Task::Rethrow() const
+    {
+        auto exception = GetException();
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
     void Task::Copy(const Task& other)
     {
+        // Releasing first would free the task when this is the last reference to it
+        if (&other == this) return;
+
         if (m_Handle != InvalidHandle)
             TaskManager::DecrementRefCount(m_Handle);
         m_Handle = other.m_Handle;
@@ -49,6 +74,12 @@ namespace Heart
         return true;
     }
 
+    void TaskGroup::Cancel() const
+    {
+        for (const Task& task : m_Tasks)
+            task.Cancel();
+    }
+
     bool TaskGroup::Wait(u32 timeout) const
     {
         auto start = std::chrono::system_clock::now();
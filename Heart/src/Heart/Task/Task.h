@@ -13,26 +13,46 @@ namespace Heart
             Medium, Low
         };
 
+        enum class Status
+        {
+            Pending = 0,
+            Succeeded, Failed, Cancelled
+        };
+
     public:
         Task() = default;
         Task(const Task& other);
-        Task(u32 handle, bool incref = true);
+        Task(u64 handle, bool incref = true);
         ~Task();
         
         bool Wait(u32 timeout = 0) const;
+
+        // Tasks that have not started yet are skipped along with everything that depends on
+        // them. A task that is already running still finishes, but its dependents are skipped
+        void Cancel() const;
+
+        // How the task finished, or Pending if it has not yet
+        Status GetStatus() const;
+
+        // The exception the task failed with, if any
+        std::exception_ptr GetException() const;
+
+        // Rethrows the exception the task failed with on the calling thread
+        void Rethrow() const;
         
-        inline u32 GetHandle() const { return m_Handle; }
+        inline u64 GetHandle() const { return m_Handle; }
         inline bool IsValid() const { return m_Handle != InvalidHandle; }
         
         inline void operator=(const Task& other) { Copy(other); }
         
-        inline static constexpr u32 InvalidHandle = std::numeric_limits<u32>::max();
+        // Packs the pool slot index with the generation of the slot when it was allocated
+        inline static constexpr u64 InvalidHandle = std::numeric_limits<u64>::max();
         
     private:
         void Copy(const Task& other);
         
     private:
-        u32 m_Handle = InvalidHandle;
+        u64 m_Handle = InvalidHandle;
     };
 
     class TaskGroup
@@ -45,6 +65,8 @@ namespace Heart
         
         bool Wait() const;
         bool Wait(u32 timeout) const;
+
+        void Cancel() const;
         
         inline const auto& GetTasks() const { return m_Tasks; }
         
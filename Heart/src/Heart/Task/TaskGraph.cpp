@@ -0,0 +1,195 @@
+#include "hepch.h"
+#include "TaskGraph.h"
+
+namespace Heart
+{
+    TaskGraph::~TaskGraph()
+    {
+        // Nodes reference the graph, so it cannot go away while they may still run
+        Wait();
+    }
+
+    u32 TaskGraph::AddNode(TaskFunction&& task, Task::Priority priority, HStringView8 name)
+    {
+        HE_ENGINE_ASSERT(!m_Compiled, "Cannot add nodes to a compiled TaskGraph");
+
+        auto node = CreateScope<Node>();
+        node->Function = std::move(task);
+        node->Name = HString8(name.Data(), name.Count());
+        node->Priority = priority;
+        m_Nodes.AddInPlace(std::move(node));
+
+        return m_Nodes.Count() - 1;
+    }
+
+    void TaskGraph::AddDependency(u32 node, u32 dependency)
+    {
+        HE_ENGINE_ASSERT(!m_Compiled, "Cannot add dependencies to a compiled TaskGraph");
+        HE_ENGINE_ASSERT(node < m_Nodes.Count() && dependency < m_Nodes.Count(), "Invalid TaskGraph node");
+
+        m_Nodes[dependency]->Dependents.Add(node);
+        m_Nodes[node]->DependencyCount++;
+    }
+
+    void TaskGraph::Compile()
+    {
+        m_Roots.Clear();
+        m_Order.Clear();
+
+        // Topologically sort so that cycles are caught here rather than hanging a launch, and so
+        // that the graph can still run in order when there are no workers
+        HVector<u32> pending;
+        pending.Resize(m_Nodes.Count(), false);
+        for (u32 i = 0; i < m_Nodes.Count(); i++)
+        {
+            pending[i] = m_Nodes[i]->DependencyCount;
+            if (pending[i] == 0)
+            {
+                m_Roots.Add(i);
+                m_Order.Add(i);
+            }
+        }
+        for (u32 i = 0; i < m_Order.Count(); i++)
+            for (u32 dependent : m_Nodes[m_Order[i]]->Dependents)
+                if (--pending[dependent] == 0)
+                    m_Order.Add(dependent);
+
+        HE_ENGINE_ASSERT(m_Order.Count() == m_Nodes.Count(), "TaskGraph contains a cycle");
+
+        m_Compiled = true;
+    }
+
+    void TaskGraph::Clear()
+    {
+        Wait();
+
+        m_Nodes.Clear();
+        m_Roots.Clear();
+        m_Order.Clear();
+        m_Completion = Task();
+        m_Compiled = false;
+    }
+
+    Task TaskGraph::Launch()
+    {
+        HE_PROFILE_FUNCTION();
+        HE_ENGINE_ASSERT(m_Compiled, "TaskGraph must be compiled before launching");
+
+        Wait();
+
+        m_FailedNode = InvalidNode;
+        m_Cancelled = false;
+        for (auto& node : m_Nodes)
+        {
+            node->Skip.store(false, std::memory_order_relaxed);
+            node->Exception = nullptr;
+        }
+
+        if (TaskManager::GetWorkerCount() == 0)
+        {
+            m_Completion = TaskManager::Schedule(
+                [this]()
+                {
+                    for (u32 node : m_Order)
+                        RunNode(node);
+                },
+                Task::Priority::High,
+                "TaskGraph"
+            );
+            return m_Completion;
+        }
+
+        m_Remaining = m_Nodes.Count();
+        m_Completion = TaskManager::ScheduleBlocked([](){}, Task::Priority::High, "TaskGraph");
+
+        // Every task has to exist before any of them are released since finishing nodes
+        // unblock their dependents directly
+        for (u32 i = 0; i < m_Nodes.Count(); i++)
+        {
+            auto& node = *m_Nodes[i];
+            node.Pending.store(node.DependencyCount, std::memory_order_relaxed);
+            node.LaunchedTask = TaskManager::ScheduleBlocked(
+                [this, i]()
+                {
+                    RunNode(i);
+                    OnNodeComplete(i);
+                },
+                node.Priority,
+                node.Name
+            );
+        }
+
+        if (m_Nodes.IsEmpty())
+            TaskManager::Unblock(m_Completion);
+        for (u32 root : m_Roots)
+            TaskManager::Unblock(m_Nodes[root]->LaunchedTask);
+
+        return m_Completion;
+    }
+
+    bool TaskGraph::Wait(u32 timeout) const
+    {
+        if (!m_Completion.IsValid()) return true;
+        return m_Completion.Wait(timeout);
+    }
+
+    void TaskGraph::Cancel()
+    {
+        m_Cancelled = true;
+    }
+
+    void TaskGraph::Rethrow() const
+    {
+        u32 failedNode = m_FailedNode.load();
+        if (failedNode != InvalidNode)
+            std::rethrow_exception(m_Nodes[failedNode]->Exception);
+    }
+
+    void TaskGraph::RunNode(u32 nodeIndex)
+    {
+        auto& node = *m_Nodes[nodeIndex];
+        bool skipDependents = node.Skip || m_Cancelled;
+        if (!skipDependents)
+        {
+            try
+            {
+                node.Function();
+            }
+            catch (const std::exception& e)
+            {
+                HE_ENGINE_LOG_WARN("TaskGraph node '{0}' failed with an exception: {1}", node.Name.Data(), e.what());
+                node.Exception = std::current_exception();
+            }
+            catch (...)
+            {
+                HE_ENGINE_LOG_WARN("TaskGraph node '{0}' failed with an unknown exception", node.Name.Data());
+                node.Exception = std::current_exception();
+            }
+
+            if (node.Exception)
+            {
+                u32 expected = InvalidNode;
+                m_FailedNode.compare_exchange_strong(expected, nodeIndex);
+                skipDependents = TaskManager::GetCancelDependentsOnFailure();
+            }
+        }
+
+        // Dependents cannot start before this node releases them, so marking them here is safe
+        if (skipDependents)
+            for (u32 dependent : node.Dependents)
+                m_Nodes[dependent]->Skip.store(true, std::memory_order_relaxed);
+    }
+
+    void TaskGraph::OnNodeComplete(u32 nodeIndex)
+    {
+        for (u32 dependent : m_Nodes[nodeIndex]->Dependents)
+        {
+            auto& dependentNode = *m_Nodes[dependent];
+            if (--dependentNode.Pending == 0)
+                TaskManager::Unblock(dependentNode.LaunchedTask);
+        }
+
+        if (--m_Remaining == 0)
+            TaskManager::Unblock(m_Completion);
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HString8.h"
+#include "Heart/Task/Task.h"
+#include "Heart/Task/TaskManager.h"
+
+namespace Heart
+{
+    // A fixed set of tasks and the dependencies between them that is compiled once and then
+    // launched as many times as needed. Dependents are resolved up front, so a launch only
+    // resets one atomic counter per node and never locks another task to register itself
+    class TaskGraph
+    {
+    public:
+        TaskGraph() = default;
+        ~TaskGraph();
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        // Returns the id of the new node. Nodes cannot be added after the graph is compiled
+        u32 AddNode(TaskFunction&& task, Task::Priority priority, HStringView8 name = "");
+
+        // The node will not start until the dependency has finished
+        void AddDependency(u32 node, u32 dependency);
+
+        void Compile();
+        void Clear();
+
+        // Starts every node and returns a task that completes once all of them have. If the
+        // previous launch is still running this waits for it first
+        Task Launch();
+
+        // Waits for the most recent launch
+        bool Wait(u32 timeout = 0) const;
+
+        // Skips every node of the current launch that has not started yet. Cancelling the node
+        // tasks directly is not supported since the graph releases dependents itself
+        void Cancel();
+
+        // Rethrows the first exception thrown by a node during the most recent launch
+        void Rethrow() const;
+
+        // The task of the node from the most recent launch
+        inline const Task& GetNodeTask(u32 node) const { return m_Nodes[node]->LaunchedTask; }
+        inline u32 GetNodeCount() const { return m_Nodes.Count(); }
+        inline bool IsCompiled() const { return m_Compiled; }
+
+    private:
+        struct Node
+        {
+            TaskFunction Function;
+            HString8 Name;
+            Task::Priority Priority;
+            HVector<u32> Dependents;
+            u32 DependencyCount = 0;
+            std::atomic<u32> Pending = 0;
+            // Set when a dependency was skipped, or failed while dependents are cancelled on failure
+            std::atomic<bool> Skip = false;
+            std::exception_ptr Exception;
+            Task LaunchedTask;
+        };
+
+    private:
+        void RunNode(u32 node);
+        void OnNodeComplete(u32 node);
+
+    private:
+        // Nodes are boxed since inline closures cannot be relocated with a memcpy
+        HVector<Scope<Node>> m_Nodes;
+        HVector<u32> m_Roots;
+        HVector<u32> m_Order;
+        std::atomic<u32> m_Remaining = 0;
+        std::atomic<u32> m_FailedNode = InvalidNode;
+        std::atomic<bool> m_Cancelled = false;
+        Task m_Completion;
+        bool m_Compiled = false;
+
+        inline static constexpr u32 InvalidNode = std::numeric_limits<u32>::max();
+    };
+}
@@ -1,10 +1,15 @@
 #include "hepch.h"
 #include "TaskManager.h"
 
+#include "Heart/Task/TaskTelemetry.h"
+#include "Heart/Task/CpuTopology.h"
+
 namespace Heart
 {
     void TaskManager::Initialize(u32 numWorkers)
     {
+        s_IsMainThread = true;
+
         if (numWorkers == 0)
         {
             s_SingleThreaded = true;
@@ -13,56 +18,121 @@ namespace Heart
             return;
         }
 
-        // Populate initial data to prevent resizing
-        s_TaskList.Resize(5000);
-        s_HandleFreeList.Reserve(s_TaskList.Count());
-        for (u32 i = 0; i < s_TaskList.Count(); i++)
-            s_HandleFreeList.Add(i);
-            
         s_Initialized = true;
         
+        s_ExecuteQueues.Resize(PriorityCount);
+        s_WorkerQueues.Resize(numWorkers);
         for (u32 i = 0; i < numWorkers; i++)
-            s_WorkerThreads.AddInPlace(&TaskManager::ProcessQueue);
+            s_WorkerThreads.AddInPlace(&TaskManager::ProcessQueue, i);
+    }
+
+    void TaskManager::Initialize(WorkerPolicy policy, bool pinWorkers)
+    {
+        HVector<u32> cores = CpuTopology::GetPreferredCores(policy == WorkerPolicy::LogicalCores);
+
+        // The first core is left for the main thread, which is not pinned since some platforms
+        // expect to manage it themselves
+        u32 numWorkers = std::max(cores.Count(), 2u) - 1;
+        if (pinWorkers && cores.Count() > 1)
+        {
+            for (u32 i = 1; i < cores.Count(); i++)
+            {
+                s_WorkerCores.Add(cores[i]);
+                s_WorkerNodes.Add(CpuTopology::GetNumaNode(cores[i]));
+            }
+        }
+
+        Initialize(numWorkers);
+    }
+
+    u32 TaskManager::GetCurrentNumaNode()
+    {
+        if (s_WorkerIndex != InvalidWorker)
+            return GetWorkerNumaNode(s_WorkerIndex);
+        return CpuTopology::GetCurrentNumaNode();
     }
 
     void TaskManager::Shutdown()
     {
+        // Flip under the sleep lock so that no worker can miss the wakeup
+        s_SleepMutex.lock();
         s_Initialized = false;
+        s_SleepMutex.unlock();
         
         // Wake all worker threads
-        s_ExecuteQueueCV.notify_all();
+        s_SleepCV.notify_all();
         
         // Now wait for completion
         for (auto& thread : s_WorkerThreads)
             thread.join();
+
+        // Leave everything ready for another Initialize. Tasks still queued at this point are dropped
+        s_WorkerThreads.Clear();
+        s_WorkerQueues.Clear();
+        s_ExecuteQueues.Clear();
+        s_MainThreadQueue.Queue.clear();
+        s_MainThreadQueue.Count = 0;
+        s_WorkerCores.Clear();
+        s_WorkerNodes.Clear();
+        for (auto& entries : s_QueueEntries)
+            entries = 0;
+        for (auto& depth : s_QueueDepths)
+            depth = 0;
+        s_SingleThreaded = false;
     }
 
-    Task TaskManager::Schedule(std::function<void()>&& task, Task::Priority priority, HStringView8 name)
+    Task TaskManager::Schedule(TaskFunction&& task, Task::Priority priority, HStringView8 name)
     {
         return Schedule(std::move(task), priority, nullptr, 0, name);
     }
 
-    Task TaskManager::Schedule(std::function<void()>&& task, Task::Priority priority, const Task& dependency, HStringView8 name)
+    Task TaskManager::Schedule(TaskFunction&& task, Task::Priority priority, const Task& dependency, HStringView8 name)
     {
         return Schedule(std::move(task), priority, &dependency, 1, name);
     }
 
-    Task TaskManager::Schedule(std::function<void()>&& task, Task::Priority priority, const TaskGroup& dependencies, HStringView8 name)
+    Task TaskManager::Schedule(TaskFunction&& task, Task::Priority priority, const TaskGroup& dependencies, HStringView8 name)
     {
         return Schedule(std::move(task), priority, dependencies.GetTasks().Data(), dependencies.GetTasks().Count(), name);
     }
 
-    Task TaskManager::Schedule(std::function<void()>&& task, Task::Priority priority, std::initializer_list<Task> dependencies, HStringView8 name)
+    Task TaskManager::Schedule(TaskFunction&& task, Task::Priority priority, std::initializer_list<Task> dependencies, HStringView8 name)
     {
         return Schedule(std::move(task), priority, dependencies.begin(), dependencies.size(), name);
     }
 
-    Task TaskManager::Schedule(std::function<void()>&& task, Task::Priority priority, const HVector<Task>& dependencies, HStringView8 name)
+    Task TaskManager::Schedule(TaskFunction&& task, Task::Priority priority, const HVector<Task>& dependencies, HStringView8 name)
     {
         return Schedule(std::move(task), priority, dependencies.Data(), dependencies.Count(), name);
     }
 
-    Task TaskManager::Schedule(std::function<void()>&& task, Task::Priority priority, const Task* dependencies, u32 dependencyCount, HStringView8 name)
+    Task TaskManager::Schedule(TaskFunction&& task, Task::Priority priority, const Task* dependencies, u32 dependencyCount, HStringView8 name)
+    {
+        return ScheduleInternal(std::move(task), priority, dependencies, dependencyCount, name, false);
+    }
+
+    Task TaskManager::ScheduleMainThread(TaskFunction&& task, HStringView8 name)
+    {
+        return ScheduleMainThread(std::move(task), nullptr, 0, name);
+    }
+
+    Task TaskManager::ScheduleMainThread(TaskFunction&& task, const Task& dependency, HStringView8 name)
+    {
+        return ScheduleMainThread(std::move(task), &dependency, 1, name);
+    }
+
+    Task TaskManager::ScheduleMainThread(TaskFunction&& task, const Task* dependencies, u32 dependencyCount, HStringView8 name)
+    {
+        return ScheduleInternal(std::move(task), Task::Priority::High, dependencies, dependencyCount, name, true);
+    }
+
+    Task TaskManager::ScheduleInternal(
+        TaskFunction&& task,
+        Task::Priority priority,
+        const Task* dependencies,
+        u32 dependencyCount,
+        HStringView8 name,
+        bool mainThread)
     {
         HE_PROFILE_FUNCTION();
 
@@ -72,163 +142,563 @@ namespace Heart
             return Task(0, false);
         }
 
-        s_FreeListMutex.lock();
-        HE_ENGINE_ASSERT(s_HandleFreeList.Count() != 0, "Scheduled too many tasks!");
-        u32 handle = s_HandleFreeList.Back();
-        s_HandleFreeList.Pop();
-        s_FreeListMutex.unlock();
-        
-        TaskData& data = s_TaskList[handle];
-        data.Mutex.lock();
-        data.Complete = false;
-        data.Success = false;
-        data.Dependents.Clear();
-        data.Task = std::move(task);
         // Start with one implicit dependency that is itself so that we can always rely on the atomic decrement
         // to determine whether or not we should execute in this function or at a later point
-        data.DependencyCount = dependencyCount + 1;
-        data.Name = HString8(name);
-        data.Priority = priority;
-        // Increase the initial refcount by one because we'll consider a task before it is completed as having a reference to
-        // itself. This saves some complexity when decrementing since we no longer need to check for completion. Increase it
-        // by an additional one because we want to ensure the task doesn't get completed and the refcount go to zero before
-        // the task object gets constructed because that would cause the refcount to go to zero twice
-        data.RefCount = 2;
-        data.Mutex.unlock();
+        u32 handle = CreateTask(std::move(task), priority, dependencyCount + 1, name, mainThread);
+        TaskData& data = s_TaskList[handle];
         
         // Cancel immediate execution if dependencies are not completed
         if (dependencyCount > 0)
         {
             for (u32 i = 0; i < dependencyCount; i++)
             {
-                if (dependencies[i].GetHandle() == Task::InvalidHandle) continue;
-                TaskData& dependencyData = s_TaskList[dependencies[i].GetHandle()];
+                // Stale handles belong to tasks that completed and were released long ago
+                u64 dependencyHandle = dependencies[i].GetHandle();
+                if (dependencyHandle == Task::InvalidHandle || !s_TaskList.IsCurrent(dependencyHandle))
+                {
+                    data.DependencyCount--;
+                    continue;
+                }
+                TaskData& dependencyData = s_TaskList[HandlePool<TaskData>::GetIndex(dependencyHandle)];
                 dependencyData.Mutex.lock();
                 if (!dependencyData.Complete)
+                {
                     dependencyData.Dependents.Add(handle);
+                    data.Dependencies.Add(dependencyHandle);
+                }
                 else
+                {
+                    if (CancelsDependents(dependencyData.Status))
+                        data.Cancelled = true;
                     data.DependencyCount--;
+                }
                 dependencyData.Mutex.unlock();
             }
         }
 
         if (--data.DependencyCount == 0)
+            OnDependenciesComplete(handle);
+        
+        return Task(s_TaskList.GetHandle(handle), false);
+    }
+
+    Task TaskManager::ScheduleBlocked(TaskFunction&& task, Task::Priority priority, HStringView8 name)
+    {
+        HE_ENGINE_ASSERT(!s_SingleThreaded, "Blocked tasks require worker threads");
+
+        u32 handle = CreateTask(std::move(task), priority, 1, name);
+        return Task(s_TaskList.GetHandle(handle), false);
+    }
+
+    void TaskManager::Unblock(const Task& task)
+    {
+        HE_ENGINE_ASSERT(s_TaskList.IsCurrent(task.GetHandle()), "Unblocking a stale task handle");
+
+        u32 handle = HandlePool<TaskData>::GetIndex(task.GetHandle());
+        if (--s_TaskList[handle].DependencyCount == 0)
+            OnDependenciesComplete(handle);
+    }
+
+    void TaskManager::OnDependenciesComplete(u32 handle)
+    {
+        // Nothing can claim a task before it is queued, so a cancelled one is ours to finish
+        if (s_TaskList[handle].Cancelled)
+            RunClaimedTask(handle);
+        else
             PushHandleToQueue(handle);
+    }
+
+    u32 TaskManager::CreateTask(TaskFunction&& task, Task::Priority priority, u32 dependencyCount, HStringView8 name, bool mainThread)
+    {
+        u32 handle = s_TaskList.Allocate();
         
-        return Task(handle, false);
+        TaskData& data = s_TaskList[handle];
+        data.Mutex.lock();
+        data.Complete = false;
+        data.Cancelled = false;
+        data.Status = Task::Status::Pending;
+        data.Exception = nullptr;
+        data.Dependents.Clear();
+        data.Dependencies.Clear();
+        data.ClaimHandle = Task::InvalidHandle;
+        data.Task = std::move(task);
+        data.DependencyCount = dependencyCount;
+        data.Name = name;
+        data.Priority = priority;
+        data.MainThread = mainThread;
+        // Increase the initial refcount by one because we'll consider a task before it is completed as having a reference to
+        // itself. This saves some complexity when decrementing since we no longer need to check for completion. Increase it
+        // by an additional one because we want to ensure the task doesn't get completed and the refcount go to zero before
+        // the task object gets constructed because that would cause the refcount to go to zero twice
+        data.RefCount = 2;
+        data.Mutex.unlock();
+
+        return handle;
     }
 
     bool TaskManager::Wait(const Task& task, u32 timeout)
     {
         if (task.GetHandle() == Task::InvalidHandle) return false;
         if (s_SingleThreaded) return true;
+        if (!s_TaskList.IsCurrent(task.GetHandle())) return true;
 
         HE_PROFILE_FUNCTION();
         
-        auto& data = s_TaskList[task.GetHandle()];
-        std::unique_lock<std::mutex> lock(data.Mutex);
-        bool complete = true;
-        if (timeout)
+        auto& data = s_TaskList[HandlePool<TaskData>::GetIndex(task.GetHandle())];
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        while (!data.Complete)
         {
-            complete = data.CompletionCV.wait_for(
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+            if (timeout && remaining.count() <= 0)
+                return false;
+
+            if (HelpWhileWaiting(task.GetHandle()))
+                continue;
+
+            // Nothing we can run right now. New work may show up at any point though, so only
+            // block for a short slice before looking again
+            std::unique_lock<std::mutex> lock(data.Mutex);
+            data.CompletionCV.wait_for(
                 lock,
-                std::chrono::milliseconds(timeout),
-                [&data]{ return data.Complete; }
+                timeout ? std::min(remaining, HelpWaitSlice) : HelpWaitSlice,
+                [&data]{ return data.Complete.load(); }
             );
         }
-        else
-            data.CompletionCV.wait(lock, [&data]{ return data.Complete; });
         
-        return complete;
+        return true;
     }
 
-    // TODO: better priority. This will likely look like having three separate queues for each
-    // priority
-    void TaskManager::PushHandleToQueue(u32 handle)
+    void TaskManager::Cancel(const Task& task)
     {
-        auto& data = s_TaskList[handle];
-        s_ExecuteQueueMutex.lock();
-        switch (data.Priority)
+        if (s_SingleThreaded || !task.IsValid()) return;
+        if (!s_TaskList.IsCurrent(task.GetHandle())) return;
+
+        auto& data = s_TaskList[HandlePool<TaskData>::GetIndex(task.GetHandle())];
+        if (data.Cancelled.exchange(true)) return;
+
+        // A queued task is finished on the spot and its queue entry is skipped once popped.
+        // Otherwise it is either running or will be finished when its dependencies are
+        if (TryClaim(task.GetHandle()))
+            RunClaimedTask(HandlePool<TaskData>::GetIndex(task.GetHandle()));
+    }
+
+    Task::Status TaskManager::GetStatus(const Task& task)
+    {
+        if (!task.IsValid()) return Task::Status::Pending;
+        if (s_SingleThreaded || !s_TaskList.IsCurrent(task.GetHandle())) return Task::Status::Succeeded;
+
+        auto& data = s_TaskList[HandlePool<TaskData>::GetIndex(task.GetHandle())];
+        if (!data.Complete) return Task::Status::Pending;
+        return data.Status;
+    }
+
+    std::exception_ptr TaskManager::GetException(const Task& task)
+    {
+        if (GetStatus(task) != Task::Status::Failed) return nullptr;
+
+        return s_TaskList[HandlePool<TaskData>::GetIndex(task.GetHandle())].Exception;
+    }
+
+    bool TaskManager::HelpWhileWaiting(u64 handle)
+    {
+        u64 claimed;
+        if (ClaimFromSubtree(handle, 0, claimed))
+        {
+            RunClaimedTask(HandlePool<TaskData>::GetIndex(claimed));
+            return true;
+        }
+
+        // Nobody else can run main thread work, so keep it moving in case what we are waiting
+        // on ends up needing it
+        if (s_IsMainThread && PopExecuteQueue(s_MainThreadQueue, claimed))
+        {
+            ExecuteTask(claimed);
+            return true;
+        }
+
+        // Only pick up unrelated work that is at least as urgent as the awaited task so that a
+        // waiter cannot get stuck behind something like a long running low priority load
+        u32 maxPriority = static_cast<u32>(s_TaskList[HandlePool<TaskData>::GetIndex(handle)].Priority);
+        for (u32 priority = 0; priority <= maxPriority; priority++)
+        {
+            if (s_QueueEntries[priority].load(std::memory_order_relaxed) == 0)
+                continue;
+            if (!FindWorkWithPriority(s_WorkerIndex, priority, claimed))
+                continue;
+
+            s_QueueEntries[priority]--;
+            ExecuteTask(claimed);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool TaskManager::ClaimFromSubtree(u64 handle, u32 depth, u64& outHandle)
+    {
+        if (!s_TaskList.IsCurrent(handle)) return false;
+
+        auto& data = s_TaskList[HandlePool<TaskData>::GetIndex(handle)];
+        if (data.Complete) return false;
+        if ((!data.MainThread || s_IsMainThread) && TryClaim(handle))
+        {
+            outHandle = handle;
+            return true;
+        }
+        if (depth == MaxHelpDepth) return false;
+
+        // A held lock means the task is being scheduled or completed, neither of which leaves
+        // anything for us to pick up below it
+        if (!data.Mutex.try_lock()) return false;
+
+        bool found = false;
+        if (s_TaskList.IsCurrent(handle))
+        {
+            for (u64 dependency : data.Dependencies)
+            {
+                if (ClaimFromSubtree(dependency, depth + 1, outHandle))
+                {
+                    found = true;
+                    break;
+                }
+            }
+        }
+        data.Mutex.unlock();
+
+        return found;
+    }
+
+    void TaskManager::PushHandleToQueue(u32 index)
+    {
+        auto& data = s_TaskList[index];
+        u32 priority = static_cast<u32>(data.Priority);
+        u64 handle = s_TaskList.GetHandle(index);
+        if (TaskTelemetry::IsEnabled())
+            data.ReadyTime = TaskTelemetry::Now();
+
+        // Workers never look at the main thread queue, so there is nobody to wake
+        if (data.MainThread)
         {
-            default:
-            case Task::Priority::High:
-            { s_ExecuteQueue.push_front(handle); } break;
-            case Task::Priority::Medium:
-            { s_ExecuteQueue.insert(s_ExecuteQueue.begin() + s_ExecuteQueue.size() / 2, handle); } break;
-            case Task::Priority::Low:
-            { s_ExecuteQueue.push_back(handle); } break;
+            data.ClaimHandle.store(handle, std::memory_order_release);
+            std::lock_guard lock(s_MainThreadQueue.Mutex);
+            s_MainThreadQueue.Queue.push_back(handle);
+            s_MainThreadQueue.Count++;
+            return;
         }
-        s_ExecuteQueueMutex.unlock();
-        s_ExecuteQueueCV.notify_one();
+
+        // Count before the task becomes claimable and before its entry is pushed so that
+        // neither counter can be observed going negative
+        s_QueueDepths[priority]++;
+        s_QueueEntries[priority]++;
+        data.ClaimHandle.store(handle, std::memory_order_release);
+
+        // Tasks spawned or released on a worker stay on that worker's deque so they run
+        // while their data is still warm
+        if (s_WorkerIndex != InvalidWorker)
+            s_WorkerQueues[s_WorkerIndex].Queues[priority].Push(handle);
+        else
+        {
+            auto& queue = s_ExecuteQueues[priority];
+            queue.Mutex.lock();
+            queue.Queue.push_back(handle);
+            queue.Count++;
+            queue.Mutex.unlock();
+        }
+
+        WakeWorker();
     }
 
-    void TaskManager::IncrementRefCount(u32 handle)
+    void TaskManager::WakeWorker()
+    {
+        s_WorkEpoch++;
+        if (s_SleepingWorkers.load() == 0)
+            return;
+
+        // Acquiring the lock guarantees a worker about to sleep either observes the new epoch
+        // or is already waiting and will receive the notification
+        s_SleepMutex.lock();
+        s_SleepMutex.unlock();
+        s_SleepCV.notify_one();
+    }
+
+    void TaskManager::IncrementRefCount(u64 handle)
     {
         if (!s_Initialized || s_SingleThreaded) return;
+        HE_ENGINE_ASSERT(s_TaskList.IsCurrent(handle), "Referencing a stale task handle");
 
-        s_TaskList[handle].RefCount++;
+        s_TaskList[HandlePool<TaskData>::GetIndex(handle)].RefCount++;
     }
 
-    void TaskManager::DecrementRefCount(u32 handle)
+    void TaskManager::DecrementRefCount(u64 handle)
     {
         if (!s_Initialized || s_SingleThreaded) return;
+        HE_ENGINE_ASSERT(s_TaskList.IsCurrent(handle), "Releasing a stale task handle");
+
+        ReleaseTask(HandlePool<TaskData>::GetIndex(handle));
+    }
 
+    void TaskManager::ReleaseTask(u32 handle)
+    {
         auto& data = s_TaskList[handle];
         if (--data.RefCount == 0)
+            s_TaskList.Free(handle);
+    }
+
+    bool TaskManager::PopExecuteQueue(ExecuteQueue& queue, u64& outHandle)
+    {
+        if (queue.Count.load(std::memory_order_relaxed) == 0)
+            return false;
+
+        std::lock_guard lock(queue.Mutex);
+        if (queue.Queue.empty())
+            return false;
+        outHandle = queue.Queue.front();
+        queue.Queue.pop_front();
+        queue.Count--;
+
+        return true;
+    }
+
+    u32 TaskManager::ProcessMainThreadQueue(double budgetMs)
+    {
+        HE_PROFILE_FUNCTION();
+        HE_ENGINE_ASSERT(s_IsMainThread, "Main thread tasks must be processed on the main thread");
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budgetMs)
+        );
+
+        u32 executed = 0;
+        u64 handle;
+        while (PopExecuteQueue(s_MainThreadQueue, handle))
         {
-            // Clear func to potentially free resources
-            data.Task = nullptr;
-            
-            s_FreeListMutex.lock();
-            s_HandleFreeList.Add(handle);
-            s_FreeListMutex.unlock();
+            // Cancelled tasks leave their entries behind
+            if (!TryClaim(handle)) continue;
+
+            RunClaimedTask(HandlePool<TaskData>::GetIndex(handle));
+            executed++;
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
         }
+
+        return executed;
     }
 
-    void TaskManager::ProcessQueue()
+    bool TaskManager::FindWorkWithPriority(u32 workerIndex, u32 priority, u64& outHandle)
     {
-        HE_PROFILE_THREAD("Task Thread");
+        // Threads outside of the pool (i.e. waiters) have no deque of their own
+        bool isWorker = workerIndex != InvalidWorker;
+        if (isWorker && s_WorkerQueues[workerIndex].Queues[priority].Pop(outHandle))
+            return true;
 
-        std::unique_lock lock(s_ExecuteQueueMutex);
-        while (s_Initialized)
+        if (PopExecuteQueue(s_ExecuteQueues[priority], outHandle))
+            return true;
+
+        // Steal from the other workers starting at our neighbor so that thieves spread out
+        u32 workerCount = s_WorkerQueues.Count();
+        u32 first = isWorker ? workerIndex + 1 : 0;
+        for (u32 i = 0; i < workerCount; i++)
         {
-            s_ExecuteQueueCV.wait(lock, []{ return !s_ExecuteQueue.empty() || !s_Initialized; });
-            
-            if (!s_Initialized) break;
-            
-            // lock already locked by wait()
-            u32 handle = s_ExecuteQueue.front();
-            s_ExecuteQueue.pop_front();
-            lock.unlock();
-            
-            auto& data = s_TaskList[handle];
-            data.Mutex.lock();
+            u32 victim = (first + i) % workerCount;
+            if (victim == workerIndex) continue;
+            if (s_WorkerQueues[victim].Queues[priority].Steal(outHandle))
+            {
+                if (TaskTelemetry::IsEnabled())
+                    TaskTelemetry::RecordSteal();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool TaskManager::FindWork(u32 workerIndex, u64& outHandle)
+    {
+        auto& worker = s_WorkerQueues[workerIndex];
+
+        // Service any level that has been passed over for too long first
+        u32 agingThreshold = s_AgingThreshold;
+        if (agingThreshold > 0)
+        {
+            for (u32 priority = PriorityCount - 1; priority > 0; priority--)
+            {
+                if (worker.Skipped[priority] < agingThreshold)
+                    continue;
+                worker.Skipped[priority] = 0;
+                if (FindWorkWithPriority(workerIndex, priority, outHandle))
+                {
+                    s_QueueEntries[priority]--;
+                    return true;
+                }
+            }
+        }
+
+        for (u32 priority = 0; priority < PriorityCount; priority++)
+        {
+            if (s_QueueEntries[priority].load(std::memory_order_relaxed) == 0)
+                continue;
+            if (!FindWorkWithPriority(workerIndex, priority, outHandle))
+                continue;
+
+            s_QueueEntries[priority]--;
+            worker.Skipped[priority] = 0;
+            for (u32 lower = priority + 1; lower < PriorityCount; lower++)
+                if (s_QueueEntries[lower].load(std::memory_order_relaxed) > 0)
+                    worker.Skipped[lower]++;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void TaskManager::WaitForWork(u32 workerIndex)
+    {
+        u64 epoch = s_WorkEpoch.load();
+
+        // Check once more now that the epoch has been captured. Any push after this point
+        // will change the epoch and prevent us from sleeping through it
+        u64 handle;
+        if (FindWork(workerIndex, handle))
+        {
+            ExecuteTask(handle);
+            return;
+        }
+
+        std::unique_lock lock(s_SleepMutex);
+        s_SleepingWorkers++;
+        s_SleepCV.wait(lock, [epoch]{ return s_WorkEpoch.load() != epoch || !s_Initialized; });
+        s_SleepingWorkers--;
+    }
+
+    bool TaskManager::TryClaim(u64 handle)
+    {
+        auto& data = s_TaskList[HandlePool<TaskData>::GetIndex(handle)];
+        u64 expected = handle;
+        if (!data.ClaimHandle.compare_exchange_strong(expected, Task::InvalidHandle, std::memory_order_acq_rel))
+            return false;
+
+        // A waiter or Cancel can claim a task before its queue entry is popped, so the task
+        // leaves the reported backlog here rather than when the entry is
+        if (!data.MainThread)
+            s_QueueDepths[static_cast<u32>(data.Priority)]--;
+        return true;
+    }
+
+    void TaskManager::ExecuteTask(u64 handle)
+    {
+        // Entries left behind by tasks that a waiter already ran are skipped here
+        if (!TryClaim(handle)) return;
+
+        RunClaimedTask(HandlePool<TaskData>::GetIndex(handle));
+    }
+
+    void TaskManager::RunClaimedTask(u32 handle)
+    {
+        HVector<u32> readyCancelled;
+        FinishTask(handle, readyCancelled);
+
+        // Cancelled dependents that became ready are finished here rather than recursively so
+        // that cancelling a long chain cannot overflow the stack
+        while (!readyCancelled.IsEmpty())
+        {
+            u32 next = readyCancelled.Back();
+            readyCancelled.Pop();
+            FinishTask(next, readyCancelled);
+        }
+    }
+
+    void TaskManager::FinishTask(u32 handle, HVector<u32>& readyCancelled)
+    {
+        // The lock is not held while the task runs so that scheduling dependents on a running
+        // task does not stall until it finishes. Only the claimer touches the function anyway
+        auto& data = s_TaskList[handle];
+        Task::Status status = Task::Status::Cancelled;
+        if (!data.Cancelled)
+        {
+            u64 startTime = TaskTelemetry::IsEnabled() ? TaskTelemetry::Now() : 0;
             try
             {
                 data.Task();
-                
-                // Set success flag
-                data.Success = true;
+                status = Task::Status::Succeeded;
             }
             catch (const std::exception& e)
             {
-                HE_ENGINE_LOG_WARN("Task '{0}' failed with an exception: {1}", s_TaskList[handle].Name.Data(), e.what());
+                HE_ENGINE_LOG_WARN("Task '{0}' failed with an exception: {1}", HString8(data.Name.Data(), data.Name.Count()).Data(), e.what());
+                data.Exception = std::current_exception();
+                status = Task::Status::Failed;
+            }
+            catch (...)
+            {
+                HE_ENGINE_LOG_WARN("Task '{0}' failed with an unknown exception", HString8(data.Name.Data(), data.Name.Count()).Data());
+                data.Exception = std::current_exception();
+                status = Task::Status::Failed;
             }
-            
-            // Mark complete and update all dependents
-            data.Complete = true;
-            for (u32 dep : data.Dependents)
+
+            if (startTime)
+                TaskTelemetry::RecordTask(data.Name, data.Priority, std::min(data.ReadyTime, startTime), startTime, TaskTelemetry::Now());
+
+            // Cancelled while running, so whatever it produced is no longer wanted
+            if (status == Task::Status::Succeeded && data.Cancelled)
+                status = Task::Status::Cancelled;
+        }
+
+        // Clear func now to free resources rather than whenever the last reference goes away
+        data.Task = nullptr;
+        
+        // Mark complete and update all dependents. When we are on a worker, released
+        // dependents are pushed onto our own deque
+        data.Mutex.lock();
+        data.Status = status;
+        data.Complete = true;
+        bool cancelDependents = CancelsDependents(status);
+        for (u32 dep : data.Dependents)
+        {
+            auto& depData = s_TaskList[dep];
+            if (cancelDependents)
+                depData.Cancelled = true;
+            if (--depData.DependencyCount == 0)
             {
-                auto& depData = s_TaskList[dep];
-                if (--depData.DependencyCount == 0)
+                if (depData.Cancelled)
+                    readyCancelled.Add(dep);
+                else
                     PushHandleToQueue(dep);
             }
-            DecrementRefCount(handle);
-            data.Mutex.unlock();
-            data.CompletionCV.notify_all();
-            
-            // Relock lock before next iteration (required by wait())
-            lock.lock();
+        }
+        ReleaseTask(handle);
+        data.Mutex.unlock();
+        data.CompletionCV.notify_all();
+    }
+
+    void TaskManager::ProcessQueue(u32 workerIndex)
+    {
+        HE_PROFILE_THREAD("Task Thread");
+
+        s_WorkerIndex = workerIndex;
+        if (!s_WorkerCores.IsEmpty() && !CpuTopology::PinCurrentThread(s_WorkerCores[workerIndex]))
+            HE_ENGINE_LOG_WARN("Failed to pin task worker {0} to core {1}", workerIndex, s_WorkerCores[workerIndex]);
+        TaskTelemetry::RegisterThread(HString8("Task Worker " + std::to_string(workerIndex)), true);
+
+        u32 idleSpins = 0;
+        while (s_Initialized)
+        {
+            u64 handle;
+            if (FindWork(workerIndex, handle))
+            {
+                idleSpins = 0;
+                ExecuteTask(handle);
+                continue;
+            }
+
+            // Briefly spin before sleeping since new work often shows up shortly after
+            if (idleSpins++ < IdleSpinCount)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            idleSpins = 0;
+            WaitForWork(workerIndex);
         }
     }
 }
@@ -1,100 +1,269 @@
 #pragma once
 
 #include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HSmallVector.hpp"
 #include "Heart/Container/HString8.h"
 #include "Heart/Task/Task.h"
+#include "Heart/Task/WorkStealingDeque.hpp"
+#include "Heart/Task/HandlePool.hpp"
+#include "Heart/Task/InlineFunction.hpp"
 
 namespace Heart
 {
+    // Sized so that closures capturing a few pointers alongside small structs or a handful
+    // of tasks are still stored inline
+    using TaskFunction = InlineFunction<void(), 128>;
+
     class TaskManager
     {
     public:
+        enum class WorkerPolicy
+        {
+            // One worker per physical core, leaving SMT siblings idle
+            PhysicalCores = 0,
+            // One worker per hardware thread
+            LogicalCores
+        };
+
+    public:
+        // Unpinned workers that the OS is free to move around
         static void Initialize(u32 numWorkers);
+
+        // Sizes the pool from the detected CPU topology, leaving one core for the main thread, and
+        // optionally pins each worker to its own core. Cores are handed out node by node
+        static void Initialize(WorkerPolicy policy, bool pinWorkers = true);
         static void Shutdown();
         
+        // Every task gets its own copy of the function since they may run after this returns
         template <class Iter, class Func>
-        static TaskGroup ScheduleIter(Func task, Iter begin, Iter end, const TaskGroup& dependencies)
+        static TaskGroup ScheduleIter(
+            Func task,
+            Iter begin,
+            Iter end,
+            const TaskGroup& dependencies,
+            Task::Priority priority = Task::Priority::Medium)
         {
             TaskGroup group;
             for (; begin != end; ++begin)
-                group.AddTask(Schedule([begin, &task](){ task(*begin); }, dependencies));
+                group.AddTask(Schedule([begin, task](){ task(*begin); }, priority, dependencies));
             return group;
         }
         
         static Task Schedule(
-            std::function<void()>&& task,
+            TaskFunction&& task,
             Task::Priority priority,
             HStringView8 name = ""
         );
         static Task Schedule(
-            std::function<void()>&& task,
+            TaskFunction&& task,
             Task::Priority priority,
             const Task& dependency,
             HStringView8 name = ""
         );
         static Task Schedule(
-            std::function<void()>&& task,
+            TaskFunction&& task,
             Task::Priority priority,
             const TaskGroup& dependencies,
             HStringView8 name = ""
         );
         static Task Schedule(
-            std::function<void()>&& task,
+            TaskFunction&& task,
             Task::Priority priority,
             std::initializer_list<Task> dependencies,
             HStringView8 name = ""
         );
         static Task Schedule(
-            std::function<void()>&& task,
+            TaskFunction&& task,
             Task::Priority priority,
             const HVector<Task>& dependencies,
             HStringView8 name = ""
         );
         static Task Schedule(
-            std::function<void()>&& task,
+            TaskFunction&& task,
             Task::Priority priority,
             const Task* dependencies,
             u32 dependencyCount,
             HStringView8 name = ""
         );
         
+        // Tasks that must run on the main thread (i.e. GPU resource creation or ImGui work). Workers
+        // never pick them up, they are run by ProcessMainThreadQueue or by the main thread while it
+        // waits on another task. With no workers they run immediately like any other task
+        static Task ScheduleMainThread(TaskFunction&& task, HStringView8 name = "");
+        static Task ScheduleMainThread(TaskFunction&& task, const Task& dependency, HStringView8 name = "");
+        static Task ScheduleMainThread(
+            TaskFunction&& task,
+            const Task* dependencies,
+            u32 dependencyCount,
+            HStringView8 name = ""
+        );
+
+        // Runs ready main thread tasks in order until the queue is empty or the budget is used up,
+        // and returns how many ran. At least one task runs per call so that the queue always
+        // makes progress. Must be called from the thread that initialized the TaskManager
+        static u32 ProcessMainThreadQueue(double budgetMs);
+
+        // Rather than sleeping, the calling thread runs ready tasks from the awaited task's
+        // dependency subtree, then any other ready task of at least the same priority, until
+        // the task completes
         static bool Wait(const Task& task, u32 timeout); // milliseconds
+
+        // Queued tasks are taken out immediately and never occupy a worker. Tasks still waiting
+        // on dependencies are finished the moment those are, again without being queued
+        static void Cancel(const Task& task);
+        static Task::Status GetStatus(const Task& task);
+        static std::exception_ptr GetException(const Task& task);
+
+        // When enabled, the dependents of a task that throws are cancelled instead of running
+        // on whatever it left behind. Cancellation itself always propagates to dependents
+        inline static void SetCancelDependentsOnFailure(bool cancel) { s_CancelDependentsOnFailure = cancel; }
+        inline static bool GetCancelDependentsOnFailure() { return s_CancelDependentsOnFailure; }
+
+        // Number of tasks of a priority that are ready to run but have not been picked up yet
+        inline static u32 GetQueueDepth(Task::Priority priority) { return s_QueueDepths[static_cast<u32>(priority)].load(std::memory_order_relaxed); }
+
+        // Number of main thread tasks that are ready to run but have not been picked up yet
+        inline static u32 GetMainThreadBacklog() { return s_MainThreadQueue.Count.load(std::memory_order_relaxed); }
+
+        inline static bool IsMainThread() { return s_IsMainThread; }
+
+        // Workers always run the highest priority ready task, but once a waiting priority level
+        // has been passed over this many times in a row a worker will service it once so that
+        // it cannot starve. Zero disables aging and gives strict priority ordering
+        inline static void SetAgingThreshold(u32 threshold) { s_AgingThreshold = threshold; }
+        inline static u32 GetAgingThreshold() { return s_AgingThreshold; }
+
+        inline static u32 GetWorkerCount() { return s_WorkerThreads.Count(); }
+
+        // NUMA node the worker was pinned to, or zero if workers are not pinned
+        inline static u32 GetWorkerNumaNode(u32 worker) { return s_WorkerNodes.IsEmpty() ? 0 : s_WorkerNodes[worker]; }
+
+        // NUMA node of the calling thread. Cheap on workers, which know where they were pinned
+        static u32 GetCurrentNumaNode();
+
+        inline static constexpr u32 PriorityCount = 3;
         
     private:
         struct TaskData
         {
-            bool Complete = false;
-            bool Success = false;
-            bool ShouldExecute = true;
-            HVector<u32> Dependents;
-            std::function<void()> Task = nullptr;
+            std::atomic<bool> Complete = false;
+            std::atomic<bool> Cancelled = false;
+            // Only valid once complete
+            Task::Status Status = Task::Status::Pending;
+            std::exception_ptr Exception;
+            // When the task was last queued, for telemetry
+            u64 ReadyTime = 0;
+            HSmallVector<u32, 4> Dependents;
+            // Dependencies that were still incomplete when the task was scheduled
+            HSmallVector<u64, 4> Dependencies;
+            // Holds the task's handle while it sits in a queue. Whoever swaps it out first gets
+            // to run the task, which lets waiters run queued tasks without removing them
+            std::atomic<u64> ClaimHandle = Heart::Task::InvalidHandle;
+            TaskFunction Task = nullptr;
             std::atomic<u32> DependencyCount = 0;
             std::atomic<u32> RefCount = 0;
             std::condition_variable CompletionCV;
             std::mutex Mutex;
-            HString8 Name;
+            // Borrowed, so names must outlive the task (i.e. literals or long lived members)
+            HStringView8 Name;
             Task::Priority Priority;
+            bool MainThread = false;
+        };
+
+        struct WorkerQueue
+        {
+            WorkStealingDeque<u64> Queues[PriorityCount];
+
+            // Consecutive picks that bypassed ready work of each priority. Only touched by the owner
+            u32 Skipped[PriorityCount] = {};
+        };
+
+        struct ExecuteQueue
+        {
+            // Not a member initializer since the main thread queue is a static of this class
+            ExecuteQueue() : Count(0) {}
+
+            std::deque<u64> Queue;
+            std::atomic<u32> Count;
+            std::mutex Mutex;
         };
 
     private:
-        static void PushHandleToQueue(u32 handle);
-        static void IncrementRefCount(u32 handle);
-        static void DecrementRefCount(u32 handle);
-        static void ProcessQueue();
+        // Creates a task that will not run until Unblock is called on it. Used by TaskGraph
+        // to release nodes without going through per-task dependency lists
+        static Task ScheduleBlocked(TaskFunction&& task, Task::Priority priority, HStringView8 name);
+        static void Unblock(const Task& task);
+
+        static Task ScheduleInternal(
+            TaskFunction&& task,
+            Task::Priority priority,
+            const Task* dependencies,
+            u32 dependencyCount,
+            HStringView8 name,
+            bool mainThread
+        );
+        static u32 CreateTask(TaskFunction&& task, Task::Priority priority, u32 dependencyCount, HStringView8 name, bool mainThread = false);
+        static void PushHandleToQueue(u32 index);
+        static void IncrementRefCount(u64 handle);
+        static void DecrementRefCount(u64 handle);
+        static void ReleaseTask(u32 handle);
+        static void ProcessQueue(u32 workerIndex);
+        static bool FindWork(u32 workerIndex, u64& outHandle);
+        static bool FindWorkWithPriority(u32 workerIndex, u32 priority, u64& outHandle);
+        static bool PopExecuteQueue(ExecuteQueue& queue, u64& outHandle);
+        static bool ClaimFromSubtree(u64 handle, u32 depth, u64& outHandle);
+        static bool HelpWhileWaiting(u64 handle);
+        static void WaitForWork(u32 workerIndex);
+        static void WakeWorker();
+        static bool TryClaim(u64 handle);
+        static void ExecuteTask(u64 handle);
+        static void RunClaimedTask(u32 handle);
+        static void FinishTask(u32 handle, HVector<u32>& readyCancelled);
+        static void OnDependenciesComplete(u32 handle);
+
+        inline static bool CancelsDependents(Task::Status status)
+        {
+            return status == Task::Status::Cancelled || (status == Task::Status::Failed && s_CancelDependentsOnFailure);
+        }
         
     private:
-        inline static std::deque<u32> s_ExecuteQueue;
-        inline static HVector<u32> s_HandleFreeList;
-        inline static HVector<TaskData> s_TaskList;
+        // Tasks scheduled from outside of the worker pool land here, and workers
+        // fall back to these before stealing from each other. One FIFO per priority
+        inline static HVector<ExecuteQueue> s_ExecuteQueues;
+        inline static HVector<WorkerQueue> s_WorkerQueues;
+        inline static ExecuteQueue s_MainThreadQueue;
+        // Tasks that are ready and unclaimed, which is what GetQueueDepth reports
+        inline static std::atomic<u32> s_QueueDepths[PriorityCount] = {};
+        // Queue entries including ones whose task was already claimed elsewhere. Workers use
+        // this to decide where to look so that those leftover entries still get drained
+        inline static std::atomic<u32> s_QueueEntries[PriorityCount] = {};
+        inline static u32 s_AgingThreshold = 32;
+        inline static bool s_CancelDependentsOnFailure = false;
+        inline static HandlePool<TaskData> s_TaskList;
         inline static HVector<std::thread> s_WorkerThreads;
+        // Empty when workers are not pinned
+        inline static HVector<u32> s_WorkerCores;
+        inline static HVector<u32> s_WorkerNodes;
         
-        inline static std::mutex s_FreeListMutex;
-        inline static std::mutex s_ExecuteQueueMutex;
-        inline static std::condition_variable s_ExecuteQueueCV;
+
+        // Idle workers sleep here. The epoch is bumped on every push so that a
+        // worker going to sleep can tell whether it raced with new work
+        inline static std::mutex s_SleepMutex;
+        inline static std::condition_variable s_SleepCV;
+        inline static std::atomic<u64> s_WorkEpoch = 0;
+        inline static std::atomic<u32> s_SleepingWorkers = 0;
+
+        inline static constexpr u32 InvalidWorker = std::numeric_limits<u32>::max();
+        inline static constexpr u32 IdleSpinCount = 64;
+        inline static constexpr u32 MaxHelpDepth = 16;
+        inline static constexpr auto HelpWaitSlice = std::chrono::microseconds(200);
+        inline static thread_local u32 s_WorkerIndex = InvalidWorker;
+        inline static thread_local bool s_IsMainThread = false;
         
-        inline static bool s_Initialized = false;
+        inline static std::atomic<bool> s_Initialized = false;
         inline static bool s_SingleThreaded = false;
         
         friend class Task;
+        friend class TaskGraph;
     };
 }
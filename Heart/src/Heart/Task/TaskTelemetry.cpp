@@ -0,0 +1,250 @@
+#include "hepch.h"
+#include "TaskTelemetry.h"
+
+#include "Heart/Util/FilesystemUtils.h"
+
+namespace Heart
+{
+    void TaskTelemetry::RegisterThread(HStringView8 name, bool isWorker)
+    {
+        if (s_ThreadBuffer.Buffer)
+        {
+            std::lock_guard lock(s_BufferMutex);
+            s_ThreadBuffer.Buffer->Name = HString8(name.Data(), name.Count());
+            s_ThreadBuffer.Buffer->IsWorker = isWorker;
+            return;
+        }
+
+        s_ThreadBuffer.Buffer = &AcquireThreadBuffer(name, isWorker);
+    }
+
+    void TaskTelemetry::RecordTask(HStringView8 name, Task::Priority priority, u64 readyTime, u64 startTime, u64 endTime)
+    {
+        auto& buffer = GetThreadBuffer();
+        u64 index = buffer.WriteIndex.load(std::memory_order_relaxed);
+
+        auto& slot = buffer.Events[index % EventBufferSize];
+        slot.Sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& event = slot.Event;
+        event.ReadyTime = readyTime;
+        event.StartTime = startTime;
+        event.EndTime = endTime;
+        event.Priority = static_cast<u8>(priority);
+        u32 nameLength = std::min(name.Count(), static_cast<u32>(sizeof(event.Name) - 1));
+        memcpy(event.Name, name.Data(), nameLength);
+        event.Name[nameLength] = 0;
+
+        slot.Sequence.store(index * 2 + 2, std::memory_order_release);
+        buffer.WriteIndex.store(index + 1, std::memory_order_release);
+
+        Increment(buffer.TasksExecuted, 1);
+        Increment(buffer.LatencyTotal, startTime - readyTime);
+        Increment(buffer.RunTimeTotal, endTime - startTime);
+        if (buffer.IsWorker)
+            Increment(buffer.WorkerRunTimeTotal, endTime - startTime);
+    }
+
+    void TaskTelemetry::RecordSteal()
+    {
+        Increment(GetThreadBuffer().Steals, 1);
+    }
+
+    void TaskTelemetry::MarkFrame()
+    {
+        Totals totals = {};
+        u32 workerCount = 0;
+        s_BufferMutex.lock();
+        for (auto& buffer : s_Buffers)
+        {
+            totals.TasksExecuted += buffer->TasksExecuted.load(std::memory_order_relaxed);
+            totals.Steals += buffer->Steals.load(std::memory_order_relaxed);
+            totals.LatencyTotal += buffer->LatencyTotal.load(std::memory_order_relaxed);
+            totals.RunTimeTotal += buffer->RunTimeTotal.load(std::memory_order_relaxed);
+            totals.WorkerRunTimeTotal += buffer->WorkerRunTimeTotal.load(std::memory_order_relaxed);
+            if (buffer->IsWorker && buffer->Alive)
+                workerCount++;
+        }
+        s_BufferMutex.unlock();
+
+        u64 now = Now();
+        u64 frameTime = s_FrameCount > 0 ? now - s_Frames[(s_FrameCount - 1) % FrameBufferSize].Time : 0;
+
+        FrameStats stats = {};
+        stats.TasksExecuted = totals.TasksExecuted - s_LastTotals.TasksExecuted;
+        stats.Steals = totals.Steals - s_LastTotals.Steals;
+        if (stats.TasksExecuted > 0)
+        {
+            stats.AverageLatency = (totals.LatencyTotal - s_LastTotals.LatencyTotal) * 0.001 / stats.TasksExecuted;
+            stats.AverageRunTime = (totals.RunTimeTotal - s_LastTotals.RunTimeTotal) * 0.001 / stats.TasksExecuted;
+        }
+        if (frameTime > 0 && workerCount > 0)
+            stats.Utilization = static_cast<double>(totals.WorkerRunTimeTotal - s_LastTotals.WorkerRunTimeTotal) / (frameTime * workerCount);
+        s_FrameStats = stats;
+        s_LastTotals = totals;
+
+        auto& frame = s_Frames[s_FrameCount % FrameBufferSize];
+        frame.Time = now;
+        frame.Utilization = stats.Utilization;
+        for (u32 i = 0; i < TaskManager::PriorityCount; i++)
+            frame.QueueDepths[i] = TaskManager::GetQueueDepth(static_cast<Task::Priority>(i));
+        frame.MainThreadBacklog = TaskManager::GetMainThreadBacklog();
+        s_FrameCount++;
+    }
+
+    nlohmann::json TaskTelemetry::ExportChromeTrace(u32 frameCount)
+    {
+        HE_PROFILE_FUNCTION();
+
+        frameCount = std::min({ frameCount, static_cast<u32>(s_FrameCount), FrameBufferSize });
+        u64 windowStart = frameCount > 0 ? s_Frames[(s_FrameCount - frameCount) % FrameBufferSize].Time : 0;
+
+        const char* priorityNames[] = { "High", "Medium", "Low" };
+        auto toMicroseconds = [](u64 time) { return time * 0.001; };
+
+        nlohmann::json events = nlohmann::json::array();
+        HVector<TaskEvent> copied;
+        copied.Reserve(EventBufferSize);
+
+        s_BufferMutex.lock();
+        for (auto& buffer : s_Buffers)
+        {
+            events.push_back({
+                { "name", "thread_name" },
+                { "ph", "M" },
+                { "pid", 0 },
+                { "tid", buffer->Id },
+                { "args", { { "name", buffer->Name.Data() } } }
+            });
+
+            // Copy first so that the owner gets as little time as possible to lap us. Slots
+            // that it is writing or has already reused show up as a sequence mismatch
+            copied.Clear();
+            u64 end = buffer->WriteIndex.load(std::memory_order_acquire);
+            u64 begin = end > EventBufferSize ? end - EventBufferSize : 0;
+            for (u64 i = begin; i < end; i++)
+            {
+                auto& slot = buffer->Events[i % EventBufferSize];
+                u64 sequence = i * 2 + 2;
+                if (slot.Sequence.load(std::memory_order_acquire) != sequence) continue;
+                TaskEvent event = slot.Event;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.Sequence.load(std::memory_order_relaxed) != sequence) continue;
+                copied.Add(event);
+            }
+
+            for (auto& event : copied)
+            {
+                if (event.EndTime < windowStart) continue;
+
+                events.push_back({
+                    { "name", event.Name },
+                    { "cat", "task" },
+                    { "ph", "X" },
+                    { "ts", toMicroseconds(event.StartTime) },
+                    { "dur", toMicroseconds(event.EndTime - event.StartTime) },
+                    { "pid", 0 },
+                    { "tid", buffer->Id },
+                    { "args", {
+                        { "priority", priorityNames[event.Priority] },
+                        { "latencyUs", toMicroseconds(event.StartTime - event.ReadyTime) }
+                    }}
+                });
+            }
+        }
+        s_BufferMutex.unlock();
+
+        for (u32 i = 0; i < frameCount; i++)
+        {
+            auto& frame = s_Frames[(s_FrameCount - frameCount + i) % FrameBufferSize];
+            events.push_back({
+                { "name", "Frame" },
+                { "ph", "i" },
+                { "s", "g" },
+                { "ts", toMicroseconds(frame.Time) },
+                { "pid", 0 },
+                { "tid", 0 }
+            });
+            events.push_back({
+                { "name", "Task Queue Depth" },
+                { "ph", "C" },
+                { "ts", toMicroseconds(frame.Time) },
+                { "pid", 0 },
+                { "args", {
+                    { priorityNames[0], frame.QueueDepths[0] },
+                    { priorityNames[1], frame.QueueDepths[1] },
+                    { priorityNames[2], frame.QueueDepths[2] },
+                    { "Main Thread", frame.MainThreadBacklog }
+                }}
+            });
+            events.push_back({
+                { "name", "Worker Utilization" },
+                { "ph", "C" },
+                { "ts", toMicroseconds(frame.Time) },
+                { "pid", 0 },
+                { "args", { { "Utilization", frame.Utilization } } }
+            });
+        }
+
+        return {
+            { "traceEvents", events },
+            { "displayTimeUnit", "ms" }
+        };
+    }
+
+    void TaskTelemetry::WriteChromeTrace(const HStringView8& path, u32 frameCount)
+    {
+        FilesystemUtils::WriteFile(path, ExportChromeTrace(frameCount));
+    }
+
+    TaskTelemetry::ThreadBuffer& TaskTelemetry::GetThreadBuffer()
+    {
+        if (!s_ThreadBuffer.Buffer)
+        {
+            // Threads that never registered (i.e. ones helping while they wait) get a generic name
+            s_ThreadBuffer.Buffer = &AcquireThreadBuffer("", false);
+        }
+
+        return *s_ThreadBuffer.Buffer;
+    }
+
+    TaskTelemetry::ThreadBuffer& TaskTelemetry::AcquireThreadBuffer(HStringView8 name, bool isWorker)
+    {
+        std::lock_guard lock(s_BufferMutex);
+
+        // Reusing a buffer keeps its counters running so that the per frame deltas stay valid.
+        // Its events belonged to the previous thread though, so they are dropped. Nobody else
+        // writes to a free buffer and exports hold the lock, so resetting here is safe
+        ThreadBuffer* buffer;
+        if (!s_FreeBuffers.IsEmpty())
+        {
+            buffer = s_FreeBuffers.Back();
+            s_FreeBuffers.Pop();
+            for (auto& slot : buffer->Events)
+                slot.Sequence.store(0, std::memory_order_relaxed);
+            buffer->WriteIndex.store(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            s_Buffers.AddInPlace(CreateScope<ThreadBuffer>());
+            buffer = s_Buffers.Back().get();
+            buffer->Id = s_Buffers.Count() - 1;
+        }
+
+        buffer->IsWorker = isWorker;
+        buffer->Alive = true;
+        buffer->Name = name.IsEmpty() ? HString8("Thread " + std::to_string(buffer->Id)) : HString8(name.Data(), name.Count());
+
+        return *buffer;
+    }
+
+    TaskTelemetry::ThreadBufferLease::~ThreadBufferLease()
+    {
+        if (!Buffer) return;
+
+        std::lock_guard lock(s_BufferMutex);
+        Buffer->Alive = false;
+        s_FreeBuffers.Add(Buffer);
+    }
+}
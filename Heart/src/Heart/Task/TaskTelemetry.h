@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+#include "Heart/Container/HString8.h"
+#include "Heart/Task/Task.h"
+#include "Heart/Task/TaskManager.h"
+#include "nlohmann/json.hpp"
+
+namespace Heart
+{
+    // Always compiled in record of what the scheduler has been doing. Every thread that runs
+    // tasks writes into its own fixed size ring buffer, so recording never takes a lock and
+    // only ever keeps the most recent events around. Buffers are handed back when their thread
+    // exits and reused by the next thread that needs one
+    class TaskTelemetry
+    {
+    public:
+        struct TaskEvent
+        {
+            // Nanoseconds since startup
+            u64 ReadyTime;
+            u64 StartTime;
+            u64 EndTime;
+            // Copied so that events outlive whatever owned the task name. Sized so that an event
+            // and its sequence fill exactly one cache line
+            char Name[31];
+            u8 Priority;
+        };
+
+        struct FrameStats
+        {
+            u64 TasksExecuted;
+            u64 Steals;
+            double AverageLatency; // Microseconds between becoming ready and starting
+            double AverageRunTime; // Microseconds
+            double Utilization; // Fraction of worker time spent running tasks
+        };
+
+    public:
+        // Names the calling thread in exported traces. Workers count towards utilization
+        static void RegisterThread(HStringView8 name, bool isWorker);
+
+        static void RecordTask(HStringView8 name, Task::Priority priority, u64 readyTime, u64 startTime, u64 endTime);
+        static void RecordSteal();
+
+        // Delimits the windows used for exports and computes the stats for the frame that just ended
+        static void MarkFrame();
+
+        // Builds a Chrome trace of the last frameCount frames that can be opened in chrome://tracing
+        // or Perfetto. Events that have already been overwritten are simply missing. Must be called
+        // from the same thread as MarkFrame
+        static nlohmann::json ExportChromeTrace(u32 frameCount);
+        static void WriteChromeTrace(const HStringView8& path, u32 frameCount);
+
+        inline static u64 Now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_StartTime).count();
+        }
+
+        inline static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+        inline static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+        inline static const FrameStats& GetFrameStats() { return s_FrameStats; }
+
+        inline static constexpr u32 EventBufferSize = 8192;
+        inline static constexpr u32 FrameBufferSize = 256;
+
+    private:
+        // Sequence is 2 * index + 1 while the event with that index is being written and
+        // 2 * index + 2 once it is complete, so readers can tell torn or lapped slots apart
+        struct EventSlot
+        {
+            std::atomic<u64> Sequence = 0;
+            TaskEvent Event;
+        };
+
+        struct ThreadBuffer
+        {
+            HString8 Name;
+            u32 Id;
+            bool IsWorker;
+            // Cleared once the owning thread exits. Only live workers count towards utilization
+            bool Alive;
+            EventSlot Events[EventBufferSize];
+            std::atomic<u64> WriteIndex = 0;
+
+            // Only written by the owning thread
+            std::atomic<u64> TasksExecuted = 0;
+            std::atomic<u64> Steals = 0;
+            std::atomic<u64> LatencyTotal = 0;
+            std::atomic<u64> RunTimeTotal = 0;
+            // Kept separately from RunTimeTotal so that it never goes backwards when a buffer
+            // changes hands between a worker and some other thread
+            std::atomic<u64> WorkerRunTimeTotal = 0;
+        };
+
+        struct FrameMarker
+        {
+            u64 Time;
+            u32 QueueDepths[TaskManager::PriorityCount];
+            u32 MainThreadBacklog;
+            double Utilization;
+        };
+
+        struct Totals
+        {
+            u64 TasksExecuted;
+            u64 Steals;
+            u64 LatencyTotal;
+            u64 RunTimeTotal;
+            u64 WorkerRunTimeTotal;
+        };
+
+    private:
+        // Returns the thread's buffer to the free list when the thread exits
+        struct ThreadBufferLease
+        {
+            constexpr ThreadBufferLease() : Buffer(nullptr) {}
+            ~ThreadBufferLease();
+
+            ThreadBuffer* Buffer;
+        };
+
+    private:
+        static ThreadBuffer& GetThreadBuffer();
+        static ThreadBuffer& AcquireThreadBuffer(HStringView8 name, bool isWorker);
+
+        inline static void Increment(std::atomic<u64>& counter, u64 amount)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+    private:
+        inline static const auto s_StartTime = std::chrono::steady_clock::now();
+        inline static std::atomic<bool> s_Enabled = true;
+
+        inline static std::mutex s_BufferMutex;
+        inline static HVector<Scope<ThreadBuffer>> s_Buffers;
+        inline static HVector<ThreadBuffer*> s_FreeBuffers;
+        inline static thread_local ThreadBufferLease s_ThreadBuffer;
+
+        // Only touched by the thread calling MarkFrame
+        inline static FrameMarker s_Frames[FrameBufferSize];
+        inline static u64 s_FrameCount = 0;
+        inline static Totals s_LastTotals = {};
+        inline static FrameStats s_FrameStats = {};
+    };
+}
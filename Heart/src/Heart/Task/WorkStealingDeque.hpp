@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Heart/Container/HVector.hpp"
+
+namespace Heart
+{
+    // Lock-free Chase-Lev work stealing deque
+    // https://fzn.fr/readings/ppopp13.pdf
+    //
+    // The owning thread pushes and pops from the bottom (LIFO) while any other
+    // thread may steal from the top (FIFO). T must be trivially copyable.
+    template <typename T>
+    class WorkStealingDeque
+    {
+    public:
+        WorkStealingDeque(u32 initialCapacity = 1024)
+        {
+            m_Buffer = new Buffer(GetNextPowerOfTwo(initialCapacity));
+        }
+
+        ~WorkStealingDeque()
+        {
+            delete m_Buffer.load(std::memory_order_relaxed);
+            for (Buffer* buffer : m_RetiredBuffers)
+                delete buffer;
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // Owner thread only
+        void Push(T value)
+        {
+            s64 bottom = m_Bottom.load(std::memory_order_relaxed);
+            s64 top = m_Top.load(std::memory_order_acquire);
+            Buffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+            if (bottom - top > buffer->Capacity - 1)
+            {
+                // Old buffers may still be read by in-flight steals, so they are
+                // kept around until the deque is destroyed
+                Buffer* grown = buffer->Grow(bottom, top);
+                m_RetiredBuffers.Add(buffer);
+                m_Buffer.store(grown, std::memory_order_release);
+                buffer = grown;
+            }
+            buffer->Put(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        // Owner thread only
+        bool Pop(T& out)
+        {
+            s64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            Buffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            s64 top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Empty
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            out = buffer->Get(bottom);
+            if (top != bottom)
+                return true;
+
+            // Last element, so race against thieves for it
+            bool won = m_Top.compare_exchange_strong(
+                top, top + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed
+            );
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        // Any thread. Returns false if the deque was empty or if another thread won the race
+        bool Steal(T& out)
+        {
+            s64 top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            s64 bottom = m_Bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return false;
+
+            Buffer* buffer = m_Buffer.load(std::memory_order_acquire);
+            T value = buffer->Get(top);
+            if (!m_Top.compare_exchange_strong(
+                top, top + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed
+            ))
+                return false;
+
+            out = value;
+            return true;
+        }
+
+        inline u32 CountApprox() const
+        {
+            s64 count = m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed);
+            return count > 0 ? static_cast<u32>(count) : 0;
+        }
+        inline bool IsEmptyApprox() const { return CountApprox() == 0; }
+
+    private:
+        struct Buffer
+        {
+            Buffer(s64 capacity)
+                : Capacity(capacity), Mask(capacity - 1), Data(new std::atomic<T>[capacity])
+            {}
+
+            ~Buffer()
+            {
+                delete[] Data;
+            }
+
+            inline T Get(s64 index) const { return Data[index & Mask].load(std::memory_order_relaxed); }
+            inline void Put(s64 index, T value) { Data[index & Mask].store(value, std::memory_order_relaxed); }
+
+            Buffer* Grow(s64 bottom, s64 top) const
+            {
+                Buffer* grown = new Buffer(Capacity * 2);
+                for (s64 i = top; i < bottom; i++)
+                    grown->Put(i, Get(i));
+                return grown;
+            }
+
+            s64 Capacity;
+            s64 Mask;
+            std::atomic<T>* Data;
+        };
+
+    private:
+        static u32 GetNextPowerOfTwo(u32 value)
+        {
+            u32 two = std::max(value, 2u) - 1;
+            two |= two >> 1;
+            two |= two >> 2;
+            two |= two >> 4;
+            two |= two >> 8;
+            two |= two >> 16;
+            return ++two;
+        }
+
+        static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque requires a trivially copyable type");
+
+        inline static constexpr u32 CacheLineSize = 64;
+
+    private:
+        // Padding keeps thieves hammering top off of the owner's cache line without requiring
+        // over-aligned storage, since deques are placed in HVectors
+        std::atomic<s64> m_Top = 0;
+        u8 m_TopPadding[CacheLineSize - sizeof(std::atomic<s64>)];
+        std::atomic<s64> m_Bottom = 0;
+        u8 m_BottomPadding[CacheLineSize - sizeof(std::atomic<s64>)];
+        std::atomic<Buffer*> m_Buffer;
+        HVector<Buffer*> m_RetiredBuffers;
+    };
+}
@@ -0,0 +1,249 @@
+#include "hepch.h"
+#include "Benchmark.h"
+
+#include "nlohmann/json.hpp"
+
+namespace Heart
+{
+    // Formats a per iteration time with a unit that keeps it readable
+    static std::string FormatNanoseconds(double ns)
+    {
+        if (ns < 1000.0)
+            return fmt::format("{:.2f} ns", ns);
+        if (ns < 1000000.0)
+            return fmt::format("{:.2f} us", ns * 0.001);
+        if (ns < 1000000000.0)
+            return fmt::format("{:.2f} ms", ns * 0.000001);
+        return fmt::format("{:.2f} s", ns * 0.000000001);
+    }
+
+    void Benchmark::EscapePointer(const volatile void* ptr)
+    {
+        // Defined out of line so that the compiler has to assume the pointer is read
+    }
+
+    void BenchmarkRunner::Register(const HString8& name, BenchmarkFunc&& func)
+    {
+        m_Benchmarks.AddInPlace(Entry{ name, std::move(func) });
+    }
+
+    void BenchmarkRunner::Run(const HString8& filter)
+    {
+        m_Results.Clear();
+        for (const auto& entry : m_Benchmarks)
+        {
+            if (!filter.IsEmpty() && entry.Name.Find(filter) == HString8::InvalidIndex)
+                continue;
+
+            m_Results.Add(RunBenchmark(entry));
+            const BenchmarkResult& result = m_Results.Back();
+            HE_ENGINE_LOG_INFO(
+                "{0}: median {1}, p95 {2}, stddev {3}, {4} allocs ({5} x {6})",
+                result.Name.Data(),
+                FormatNanoseconds(result.MedianNs),
+                FormatNanoseconds(result.P95Ns),
+                FormatNanoseconds(result.StdDevNs),
+                result.AllocationsPerIteration < 0.0 ? "?" : fmt::format("{:.2f}", result.AllocationsPerIteration),
+                result.Samples,
+                result.Iterations
+            );
+        }
+    }
+
+    double BenchmarkRunner::RunSample(const BenchmarkFunc& func, u64 iterations, u64& outAllocations)
+    {
+        BenchmarkState state(iterations);
+        u64 allocations = Benchmark::GetAllocationCount();
+
+        state.m_Start = BenchmarkState::Clock::now();
+        func(state);
+        state.m_Elapsed += BenchmarkState::Clock::now() - state.m_Start;
+
+        outAllocations = Benchmark::GetAllocationCount() - allocations - state.m_AllocationsExcluded;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(state.m_Elapsed).count());
+    }
+
+    u64 BenchmarkRunner::CalibrateIterations(const BenchmarkFunc& func)
+    {
+        double target = m_Settings.MinSampleSeconds * 1000000000.0;
+        u64 iterations = 1;
+        u64 allocations;
+        while (iterations < m_Settings.MaxIterations)
+        {
+            double elapsed = RunSample(func, iterations, allocations);
+            if (elapsed >= target)
+                break;
+
+            // Aim a bit past the target so that noise doesn't land the next attempt just short
+            // of it, but never grow too fast off of a sample that was mostly timer overhead
+            double scale = elapsed > 0.0 ? target * 1.4 / elapsed : 10.0;
+            scale = std::clamp(scale, 1.5, 10.0);
+            iterations = std::min(static_cast<u64>(std::ceil(iterations * scale)), m_Settings.MaxIterations);
+        }
+
+        return iterations;
+    }
+
+    BenchmarkResult BenchmarkRunner::RunBenchmark(const Entry& entry)
+    {
+        // Calibration doubles as the first part of the warmup
+        auto warmupStart = std::chrono::high_resolution_clock::now();
+        u64 iterations = CalibrateIterations(entry.Func);
+        u64 allocations;
+        while (std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - warmupStart).count() < m_Settings.WarmupSeconds)
+            RunSample(entry.Func, iterations, allocations);
+
+        u32 sampleCount = std::max(m_Settings.SampleCount, 1u);
+        HVector<double> samples;
+        samples.Reserve(sampleCount);
+        u64 totalAllocations = 0;
+        for (u32 i = 0; i < sampleCount; i++)
+        {
+            samples.Add(RunSample(entry.Func, iterations, allocations) / iterations);
+            totalAllocations += allocations;
+        }
+        std::sort(samples.begin(), samples.end());
+
+        double mean = 0.0;
+        for (double sample : samples)
+            mean += sample;
+        mean /= sampleCount;
+
+        double variance = 0.0;
+        for (double sample : samples)
+            variance += (sample - mean) * (sample - mean);
+        variance = sampleCount > 1 ? variance / (sampleCount - 1) : 0.0;
+
+        BenchmarkResult result;
+        result.Name = entry.Name;
+        result.Iterations = iterations;
+        result.Samples = sampleCount;
+        result.MedianNs = sampleCount % 2 ? samples[sampleCount / 2] : (samples[sampleCount / 2 - 1] + samples[sampleCount / 2]) * 0.5;
+        result.MeanNs = mean;
+        result.P95Ns = samples[static_cast<u32>(std::ceil(sampleCount * 0.95)) - 1]; // Nearest rank
+        result.MinNs = samples[0];
+        result.StdDevNs = std::sqrt(variance);
+        result.AllocationsPerIteration = m_Settings.CountAllocations
+            ? static_cast<double>(totalAllocations) / (static_cast<double>(iterations) * sampleCount)
+            : -1.0;
+
+        return result;
+    }
+
+    bool BenchmarkRunner::WriteJson(const HString8& path) const
+    {
+        nlohmann::json benchmarks = nlohmann::json::array();
+        for (const auto& result : m_Results)
+        {
+            nlohmann::json j = {
+                { "name", result.Name.Data() },
+                { "iterations", result.Iterations },
+                { "samples", result.Samples },
+                { "medianNs", result.MedianNs },
+                { "meanNs", result.MeanNs },
+                { "p95Ns", result.P95Ns },
+                { "minNs", result.MinNs },
+                { "stdDevNs", result.StdDevNs },
+                { "allocationsPerIteration", nullptr }
+            };
+            if (result.AllocationsPerIteration >= 0.0)
+                j["allocationsPerIteration"] = result.AllocationsPerIteration;
+            benchmarks.push_back(j);
+        }
+
+        std::ofstream file(path.Data());
+        if (!file.is_open())
+        {
+            HE_ENGINE_LOG_ERROR("Failed to open '{0}' for writing benchmark results", path.Data());
+            return false;
+        }
+
+        file << nlohmann::json({ { "benchmarks", benchmarks } }).dump(4);
+        return true;
+    }
+
+    bool BenchmarkRunner::WriteCsv(const HString8& path) const
+    {
+        std::ofstream file(path.Data());
+        if (!file.is_open())
+        {
+            HE_ENGINE_LOG_ERROR("Failed to open '{0}' for writing benchmark results", path.Data());
+            return false;
+        }
+
+        file << "name,iterations,samples,medianNs,meanNs,p95Ns,minNs,stdDevNs,allocationsPerIteration\n";
+        for (const auto& result : m_Results)
+        {
+            // Names are quoted since they are free form
+            std::string name = result.Name.Data();
+            for (size_t i = name.find('"'); i != std::string::npos; i = name.find('"', i + 2))
+                name.insert(i, 1, '"');
+
+            file << fmt::format(
+                "\"{0}\",{1},{2},{3},{4},{5},{6},{7},{8}\n",
+                name,
+                result.Iterations,
+                result.Samples,
+                result.MedianNs,
+                result.MeanNs,
+                result.P95Ns,
+                result.MinNs,
+                result.StdDevNs,
+                result.AllocationsPerIteration < 0.0 ? "" : fmt::format("{}", result.AllocationsPerIteration)
+            );
+        }
+
+        return true;
+    }
+
+    u32 BenchmarkRunner::CompareToBaseline(const HString8& path, double threshold) const
+    {
+        std::ifstream file(path.Data());
+        nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+        if (!file.is_open() || baseline.is_discarded() || !baseline.contains("benchmarks"))
+        {
+            HE_ENGINE_LOG_ERROR("Failed to load benchmark baseline '{0}'", path.Data());
+            return 0;
+        }
+
+        std::unordered_map<std::string, double> baselineMedians;
+        for (const auto& j : baseline["benchmarks"])
+            baselineMedians[j["name"].get<std::string>()] = j["medianNs"].get<double>();
+
+        u32 regressions = 0;
+        for (const auto& result : m_Results)
+        {
+            auto found = baselineMedians.find(result.Name.Data());
+            if (found == baselineMedians.end())
+            {
+                HE_ENGINE_LOG_INFO("{0}: not in baseline", result.Name.Data());
+                continue;
+            }
+
+            double change = result.MedianNs / found->second - 1.0;
+            if (change > threshold)
+            {
+                regressions++;
+                HE_ENGINE_LOG_WARN(
+                    "{0}: REGRESSION {1} -> {2} ({3:+.1f}%)",
+                    result.Name.Data(),
+                    FormatNanoseconds(found->second),
+                    FormatNanoseconds(result.MedianNs),
+                    change * 100.0
+                );
+            }
+            else
+            {
+                HE_ENGINE_LOG_INFO(
+                    "{0}: {1} -> {2} ({3:+.1f}%)",
+                    result.Name.Data(),
+                    FormatNanoseconds(found->second),
+                    FormatNanoseconds(result.MedianNs),
+                    change * 100.0
+                );
+            }
+        }
+
+        return regressions;
+    }
+}
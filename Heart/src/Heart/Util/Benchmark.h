@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Heart/Container/HString8.h"
+#include "Heart/Container/HVector.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace Heart
+{
+    struct Benchmark
+    {
+        // Forces value to be computed and kept in memory, as if something outside of the compiler's
+        // view had read it
+        template <typename T>
+        inline static void DoNotOptimize(const T& value)
+        {
+            #if defined(_MSC_VER) && !defined(__clang__)
+                EscapePointer(&reinterpret_cast<const volatile char&>(value));
+                _ReadWriteBarrier();
+            #else
+                asm volatile("" : : "r"(&value) : "memory");
+            #endif
+        }
+
+        // Forces every pending write to memory to actually happen here
+        inline static void ClobberMemory()
+        {
+            #if defined(_MSC_VER) && !defined(__clang__)
+                _ReadWriteBarrier();
+            #else
+                asm volatile("" : : : "memory");
+            #endif
+        }
+
+        inline static void RecordAllocation() { s_AllocationCount.fetch_add(1, std::memory_order_relaxed); }
+        inline static u64 GetAllocationCount() { return s_AllocationCount.load(std::memory_order_relaxed); }
+
+    private:
+        static void EscapePointer(const volatile void* ptr);
+
+    private:
+        inline static std::atomic<u64> s_AllocationCount = 0;
+    };
+
+    // Passed to every benchmark function. The function must run the measured work exactly
+    // GetIterations() times, and can pause the clock around per iteration setup
+    class BenchmarkState
+    {
+    public:
+        BenchmarkState(u64 iterations)
+            : m_Iterations(iterations)
+        {}
+
+        inline void PauseTiming()
+        {
+            m_Elapsed += Clock::now() - m_Start;
+            m_AllocationsPaused = Benchmark::GetAllocationCount();
+        }
+
+        inline void ResumeTiming()
+        {
+            m_AllocationsExcluded += Benchmark::GetAllocationCount() - m_AllocationsPaused;
+            m_Start = Clock::now();
+        }
+
+        inline u64 GetIterations() const { return m_Iterations; }
+
+    private:
+        using Clock = std::chrono::high_resolution_clock;
+
+    private:
+        u64 m_Iterations;
+        Clock::time_point m_Start;
+        Clock::duration m_Elapsed = Clock::duration::zero();
+        u64 m_AllocationsPaused = 0;
+        u64 m_AllocationsExcluded = 0;
+
+        friend class BenchmarkRunner;
+    };
+
+    struct BenchmarkResult
+    {
+        HString8 Name;
+        u64 Iterations; // Per sample
+        u32 Samples;
+        double MedianNs; // All times are per iteration
+        double MeanNs;
+        double P95Ns;
+        double MinNs;
+        double StdDevNs;
+        double AllocationsPerIteration; // Negative if allocations were not counted
+    };
+
+    struct BenchmarkSettings
+    {
+        u32 SampleCount = 15;
+        double MinSampleSeconds = 0.01; // Iterations are calibrated so that each sample takes at least this long
+        double WarmupSeconds = 0.05;
+        u64 MaxIterations = 1000000000;
+
+        // Only set this if the executable replaces the global allocation functions and calls
+        // Benchmark::RecordAllocation from them
+        bool CountAllocations = false;
+    };
+
+    // Runs registered benchmarks with warmup and calibrated iteration counts, and reports
+    // statistics over a number of samples so that results can be compared between runs
+    class BenchmarkRunner
+    {
+    public:
+        using BenchmarkFunc = std::function<void(BenchmarkState&)>;
+
+    public:
+        BenchmarkRunner(const BenchmarkSettings& settings = BenchmarkSettings())
+            : m_Settings(settings)
+        {}
+
+        void Register(const HString8& name, BenchmarkFunc&& func);
+
+        // Runs every benchmark whose name contains filter, or all of them if it is empty
+        void Run(const HString8& filter = "");
+
+        // Writes the results of the last run
+        bool WriteJson(const HString8& path) const;
+        bool WriteCsv(const HString8& path) const;
+
+        // Compares median times against a file written by WriteJson and logs each benchmark
+        // that got slower by more than threshold (0.1 = 10%). Returns the number of regressions
+        u32 CompareToBaseline(const HString8& path, double threshold) const;
+
+        inline const HVector<BenchmarkResult>& GetResults() const { return m_Results; }
+
+    private:
+        struct Entry
+        {
+            HString8 Name;
+            BenchmarkFunc Func;
+        };
+
+    private:
+        double RunSample(const BenchmarkFunc& func, u64 iterations, u64& outAllocations);
+        u64 CalibrateIterations(const BenchmarkFunc& func);
+        BenchmarkResult RunBenchmark(const Entry& entry);
+
+    private:
+        BenchmarkSettings m_Settings;
+        HVector<Entry> m_Benchmarks;
+        HVector<BenchmarkResult> m_Results;
+    };
+}
@@ -1,11 +0,0 @@
-#pragma once
-
-namespace Heart
-{
-    struct PerfTests
-    {
-        static void RunHStringTest();
-        static void RunHArrayTest();
-        static void RunHVectorTest();
-    };
-}
\ No newline at end of file
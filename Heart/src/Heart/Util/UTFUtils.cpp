@@ -0,0 +1,395 @@
+#include "hepch.h"
+#include "UTFUtils.h"
+
+// SSE2 is part of the x64 baseline. AVX2 is only used when the compiler is allowed to emit it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define HE_UTF_SSE2
+    #include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+    #define HE_UTF_AVX2
+    #include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace Heart
+{
+    // Returned by the decoders for malformed input
+    static constexpr u32 InvalidCodePoint = 0xFFFFFFFF;
+
+    static inline u32 PopCount(u32 value)
+    {
+        #ifdef _MSC_VER
+            return __popcnt(value);
+        #else
+            return __builtin_popcount(value);
+        #endif
+    }
+
+    // Decodes the code point starting at str[index] and moves index past it. A malformed
+    // sequence consumes its longest valid prefix (at least one byte) so that the next decode
+    // resynchronizes on the following lead byte
+    static inline u32 DecodeUTF8(const char8* str, u32 len, u32& index)
+    {
+        u8 lead = (u8)str[index++];
+        if (lead < 0x80) return lead;
+
+        // Second byte ranges exclude overlong encodings, surrogates and anything past U+10FFFF
+        u32 remaining;
+        u32 codePoint;
+        u8 low = 0x80;
+        u8 high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            remaining = 1;
+            codePoint = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            remaining = 2;
+            codePoint = lead & 0x0F;
+            if (lead == 0xE0) low = 0xA0;
+            else if (lead == 0xED) high = 0x9F;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            remaining = 3;
+            codePoint = lead & 0x07;
+            if (lead == 0xF0) low = 0x90;
+            else if (lead == 0xF4) high = 0x8F;
+        }
+        else
+            return InvalidCodePoint;
+
+        for (; remaining > 0; remaining--)
+        {
+            if (index >= len) return InvalidCodePoint;
+            u8 byte = (u8)str[index];
+            if (byte < low || byte > high) return InvalidCodePoint;
+            codePoint = (codePoint << 6) | (byte & 0x3F);
+            low = 0x80;
+            high = 0xBF;
+            index++;
+        }
+
+        return codePoint;
+    }
+
+    static inline u32 DecodeUTF16(const char16* str, u32 len, u32& index)
+    {
+        u32 unit = str[index++];
+        if (unit < 0xD800 || unit > 0xDFFF) return unit;
+
+        if (unit <= 0xDBFF && index < len && str[index] >= 0xDC00 && str[index] <= 0xDFFF)
+            return 0x10000 + ((unit - 0xD800) << 10) + (str[index++] - 0xDC00);
+
+        return InvalidCodePoint;
+    }
+
+    static inline u32 GetUTF8Size(u32 codePoint)
+    {
+        if (codePoint < 0x80) return 1;
+        if (codePoint < 0x800) return 2;
+        if (codePoint < 0x10000) return 3;
+        return 4;
+    }
+
+    static inline u32 EncodeUTF8(u32 codePoint, char8* dst)
+    {
+        if (codePoint < 0x80)
+        {
+            dst[0] = (char8)codePoint;
+            return 1;
+        }
+        if (codePoint < 0x800)
+        {
+            dst[0] = (char8)(0xC0 | (codePoint >> 6));
+            dst[1] = (char8)(0x80 | (codePoint & 0x3F));
+            return 2;
+        }
+        if (codePoint < 0x10000)
+        {
+            dst[0] = (char8)(0xE0 | (codePoint >> 12));
+            dst[1] = (char8)(0x80 | ((codePoint >> 6) & 0x3F));
+            dst[2] = (char8)(0x80 | (codePoint & 0x3F));
+            return 3;
+        }
+        dst[0] = (char8)(0xF0 | (codePoint >> 18));
+        dst[1] = (char8)(0x80 | ((codePoint >> 12) & 0x3F));
+        dst[2] = (char8)(0x80 | ((codePoint >> 6) & 0x3F));
+        dst[3] = (char8)(0x80 | (codePoint & 0x3F));
+        return 4;
+    }
+
+    static inline u32 EncodeUTF16(u32 codePoint, char16* dst)
+    {
+        if (codePoint < 0x10000)
+        {
+            dst[0] = (char16)codePoint;
+            return 1;
+        }
+        codePoint -= 0x10000;
+        dst[0] = (char16)(0xD800 + (codePoint >> 10));
+        dst[1] = (char16)(0xDC00 + (codePoint & 0x3FF));
+        return 2;
+    }
+
+    // The block functions below process whole blocks from the start of str for as long as
+    // they are ASCII and return how many elements were consumed, leaving the rest to the
+    // scalar path
+
+    static u32 SkipASCII(const char8* str, u32 len)
+    {
+        u32 i = 0;
+        #ifdef HE_UTF_AVX2
+            for (; i + 32 <= len; i += 32)
+                if (_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(str + i))) != 0)
+                    return i;
+        #endif
+        #ifdef HE_UTF_SSE2
+            for (; i + 16 <= len; i += 16)
+                if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(str + i))) != 0)
+                    return i;
+        #else
+            for (; i + 8 <= len; i += 8)
+            {
+                u64 word;
+                memcpy(&word, str + i, sizeof(word));
+                if ((word & 0x8080808080808080ull) != 0)
+                    return i;
+            }
+        #endif
+        return i;
+    }
+
+    static u32 WidenASCII(const char8* str, u32 len, char16* dst)
+    {
+        u32 i = 0;
+        #ifdef HE_UTF_AVX2
+            for (; i + 32 <= len; i += 32)
+            {
+                __m256i bytes = _mm256_loadu_si256((const __m256i*)(str + i));
+                if (_mm256_movemask_epi8(bytes) != 0) return i;
+                _mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+                _mm256_storeu_si256((__m256i*)(dst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+            }
+        #endif
+        #ifdef HE_UTF_SSE2
+            __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= len; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128((const __m128i*)(str + i));
+                if (_mm_movemask_epi8(bytes) != 0) return i;
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(bytes, zero));
+                _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+            }
+        #else
+            for (; i + 8 <= len; i += 8)
+            {
+                u64 word;
+                memcpy(&word, str + i, sizeof(word));
+                if ((word & 0x8080808080808080ull) != 0) return i;
+                for (u32 j = 0; j < 8; j++)
+                    dst[i + j] = (char16)(u8)str[i + j];
+            }
+        #endif
+        return i;
+    }
+
+    static u32 SkipASCII(const char16* str, u32 len)
+    {
+        u32 i = 0;
+        #ifdef HE_UTF_AVX2
+            __m256i wideMask = _mm256_set1_epi16((short)0xFF80);
+            for (; i + 16 <= len; i += 16)
+                if (!_mm256_testz_si256(_mm256_loadu_si256((const __m256i*)(str + i)), wideMask))
+                    return i;
+        #endif
+        #ifdef HE_UTF_SSE2
+            __m128i mask = _mm_set1_epi16((short)0xFF80);
+            __m128i zero = _mm_setzero_si128();
+            for (; i + 8 <= len; i += 8)
+            {
+                __m128i units = _mm_and_si128(_mm_loadu_si128((const __m128i*)(str + i)), mask);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(units, zero)) != 0xFFFF)
+                    return i;
+            }
+        #else
+            for (; i + 4 <= len; i += 4)
+            {
+                u64 word;
+                memcpy(&word, str + i, sizeof(word));
+                if ((word & 0xFF80FF80FF80FF80ull) != 0)
+                    return i;
+            }
+        #endif
+        return i;
+    }
+
+    static u32 NarrowASCII(const char16* str, u32 len, char8* dst)
+    {
+        u32 i = 0;
+        #ifdef HE_UTF_AVX2
+            __m256i wideMask = _mm256_set1_epi16((short)0xFF80);
+            for (; i + 32 <= len; i += 32)
+            {
+                __m256i first = _mm256_loadu_si256((const __m256i*)(str + i));
+                __m256i second = _mm256_loadu_si256((const __m256i*)(str + i + 16));
+                if (!_mm256_testz_si256(_mm256_or_si256(first, second), wideMask)) return i;
+                // packus works within 128 bit lanes so the middle quarters come out swapped
+                __m256i packed = _mm256_packus_epi16(first, second);
+                _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+            }
+        #endif
+        #ifdef HE_UTF_SSE2
+            __m128i mask = _mm_set1_epi16((short)0xFF80);
+            __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= len; i += 16)
+            {
+                __m128i first = _mm_loadu_si128((const __m128i*)(str + i));
+                __m128i second = _mm_loadu_si128((const __m128i*)(str + i + 8));
+                __m128i high = _mm_and_si128(_mm_or_si128(first, second), mask);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) return i;
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(first, second));
+            }
+        #else
+            for (; i + 4 <= len; i += 4)
+            {
+                u64 word;
+                memcpy(&word, str + i, sizeof(word));
+                if ((word & 0xFF80FF80FF80FF80ull) != 0) return i;
+                for (u32 j = 0; j < 4; j++)
+                    dst[i + j] = (char8)str[i + j];
+            }
+        #endif
+        return i;
+    }
+
+    u32 UTFUtils::GetUTF16Length(const char8* str, u32 len)
+    {
+        u32 count = 0;
+        u32 i = 0;
+        while (i < len)
+        {
+            u32 skipped = SkipASCII(str + i, len - i);
+            count += skipped;
+            i += skipped;
+            if (i >= len) break;
+
+            u32 codePoint = DecodeUTF8(str, len, i);
+            count += codePoint != InvalidCodePoint && codePoint >= 0x10000 ? 2 : 1;
+        }
+
+        return count;
+    }
+
+    u32 UTFUtils::GetUTF8Length(const char16* str, u32 len)
+    {
+        u32 count = 0;
+        u32 i = 0;
+        while (i < len)
+        {
+            u32 skipped = SkipASCII(str + i, len - i);
+            count += skipped;
+            i += skipped;
+
+            #ifdef HE_UTF_SSE2
+                // Text outside of ASCII is mostly made of two and three byte characters, so
+                // blocks without surrogates are counted directly from the unit ranges
+                __m128i zero = _mm_setzero_si128();
+                __m128i asciiMask = _mm_set1_epi16((short)0xFF80);
+                __m128i twoByteMask = _mm_set1_epi16((short)0xF800);
+                __m128i surrogate = _mm_set1_epi16((short)0xD800);
+                for (; i + 8 <= len; i += 8)
+                {
+                    __m128i units = _mm_loadu_si128((const __m128i*)(str + i));
+                    __m128i high = _mm_and_si128(units, twoByteMask);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogate)) != 0) break;
+
+                    u32 ascii = PopCount(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, asciiMask), zero)));
+                    u32 twoByte = PopCount(_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)));
+                    // Masks have two bits per unit
+                    count += 24 - (ascii + twoByte) / 2;
+                }
+            #endif
+            if (i >= len) break;
+
+            u32 codePoint = DecodeUTF16(str, len, i);
+            count += codePoint == InvalidCodePoint ? 3 : GetUTF8Size(codePoint);
+        }
+
+        return count;
+    }
+
+    u32 UTFUtils::ConvertUTF8ToUTF16(const char8* str, u32 len, char16* dst)
+    {
+        u32 written = 0;
+        u32 i = 0;
+        while (i < len)
+        {
+            u32 widened = WidenASCII(str + i, len - i, dst + written);
+            written += widened;
+            i += widened;
+            if (i >= len) break;
+
+            u32 codePoint = DecodeUTF8(str, len, i);
+            if (codePoint == InvalidCodePoint)
+                codePoint = ReplacementCharacter;
+            written += EncodeUTF16(codePoint, dst + written);
+        }
+
+        return written;
+    }
+
+    u32 UTFUtils::ConvertUTF16ToUTF8(const char16* str, u32 len, char8* dst)
+    {
+        u32 written = 0;
+        u32 i = 0;
+        while (i < len)
+        {
+            u32 narrowed = NarrowASCII(str + i, len - i, dst + written);
+            written += narrowed;
+            i += narrowed;
+            if (i >= len) break;
+
+            u32 codePoint = DecodeUTF16(str, len, i);
+            if (codePoint == InvalidCodePoint)
+                codePoint = ReplacementCharacter;
+            written += EncodeUTF8(codePoint, dst + written);
+        }
+
+        return written;
+    }
+
+    bool UTFUtils::IsValidUTF8(const char8* str, u32 len)
+    {
+        u32 i = 0;
+        while (i < len)
+        {
+            i += SkipASCII(str + i, len - i);
+            if (i >= len) break;
+
+            if (DecodeUTF8(str, len, i) == InvalidCodePoint)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool UTFUtils::IsValidUTF16(const char16* str, u32 len)
+    {
+        u32 i = 0;
+        while (i < len)
+        {
+            i += SkipASCII(str + i, len - i);
+            if (i >= len) break;
+
+            if (DecodeUTF16(str, len, i) == InvalidCodePoint)
+                return false;
+        }
+
+        return true;
+    }
+}
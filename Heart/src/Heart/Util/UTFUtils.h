@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Heart
+{
+    // Validation and transcoding between UTF8 and UTF16. Runs of ASCII are handled in SIMD
+    // blocks and everything else goes through a scalar decoder. Malformed sequences and lone
+    // surrogates are written as U+FFFD, and the length functions account for this so that
+    // they always match what the conversion writes
+    class UTFUtils
+    {
+    public:
+        // Number of UTF16 code units needed to hold the converted string, not including a terminator
+        static u32 GetUTF16Length(const char8* str, u32 len);
+
+        // Number of UTF8 bytes needed to hold the converted string, not including a terminator
+        static u32 GetUTF8Length(const char16* str, u32 len);
+
+        // Writes GetUTF16Length(str, len) code units to dst and returns that count
+        static u32 ConvertUTF8ToUTF16(const char8* str, u32 len, char16* dst);
+
+        // Writes GetUTF8Length(str, len) bytes to dst and returns that count
+        static u32 ConvertUTF16ToUTF8(const char16* str, u32 len, char8* dst);
+
+        static bool IsValidUTF8(const char8* str, u32 len);
+        static bool IsValidUTF16(const char16* str, u32 len);
+
+        inline static constexpr u32 ReplacementCharacter = 0xFFFD;
+    };
+}
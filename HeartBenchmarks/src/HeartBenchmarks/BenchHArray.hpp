@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Heart/Util/Benchmark.h"
+#include "Heart/Container/HArray.h"
+#include "Heart/Container/HString.h"
+
+namespace HArrayBenchmarks
+{
+    template <typename Func>
+    void RegisterAdd(Heart::BenchmarkRunner& runner, const char* name, Func&& add)
+    {
+        runner.Register(name, [add](Heart::BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                Heart::HArray arr;
+                for (u32 j = 0; j < 100000; j++)
+                    add(arr);
+                Heart::Benchmark::DoNotOptimize(arr);
+            }
+        });
+    }
+
+    inline Heart::HArray MakeStringArray(u32 count)
+    {
+        Heart::HArray arr;
+        for (u32 i = 0; i < count; i++)
+            arr.Add(Heart::HString(std::to_string(i)));
+        return arr;
+    }
+
+    inline void Register(Heart::BenchmarkRunner& runner)
+    {
+        using Heart::Benchmark;
+        using Heart::BenchmarkState;
+        using Heart::HArray;
+
+        // One iteration adds 100k elements to a fresh array
+        RegisterAdd(runner, "HArray - Add Strings", [](HArray& arr) { arr.Add(Heart::HString("brejiment")); });
+        RegisterAdd(runner, "HArray - Add String Views", [](HArray& arr) { arr.Add(Heart::HStringView("brejiment")); });
+        RegisterAdd(runner, "HArray - Add Long String Views", [](HArray& arr) { arr.Add(Heart::HStringView("brejiment but longer")); });
+        RegisterAdd(runner, "HArray - Add Integers", [](HArray& arr) { arr.Add(12345); });
+        RegisterAdd(runner, "HArray - Add Nested Arrays", [](HArray& arr) { arr.Add(HArray()); }); // C# parity
+
+        runner.Register("HArray - Clone Strings", [](BenchmarkState& state)
+        {
+            state.PauseTiming();
+            HArray arr = MakeStringArray(1000);
+            state.ResumeTiming();
+
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HArray clone = arr.Clone();
+                Benchmark::DoNotOptimize(clone);
+            }
+        });
+
+        runner.Register("HArray - Json Round Trip", [](BenchmarkState& state)
+        {
+            state.PauseTiming();
+            HArray arr = MakeStringArray(1000);
+            state.ResumeTiming();
+
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                nlohmann::json j = arr;
+                HArray parsed = j.get<HArray>();
+                HE_ENGINE_ASSERT(parsed.Count() == arr.Count());
+                Benchmark::DoNotOptimize(parsed);
+            }
+        });
+    }
+}
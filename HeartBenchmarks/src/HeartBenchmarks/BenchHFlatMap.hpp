@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Heart/Util/Benchmark.h"
+#include "Heart/Container/HFlatMap.hpp"
+
+// Every map benchmark is registered once for HFlatMap and once for std::unordered_map through a
+// small adapter, so both sides always run exactly the same workload
+namespace HFlatMapBenchmarks
+{
+    // Keys spaced out like pointers, which is what most engine maps are keyed on. A power of two
+    // so that lookups can wrap around with a mask
+    inline constexpr u32 KeyCount = 1 << 20;
+
+    inline const Heart::HVector<u64>& GetKeys()
+    {
+        static Heart::HVector<u64> keys = []()
+        {
+            Heart::HVector<u64> keys;
+            keys.Reserve(KeyCount);
+            for (u32 i = 0; i < KeyCount; i++)
+                keys.Add((u64)i * 4096);
+            return keys;
+        }();
+        return keys;
+    }
+
+    struct FlatMapAdapter
+    {
+        inline static constexpr const char* Name = "HFlatMap";
+
+        inline void Insert(u64 key, u32 value) { Map[key] = value; }
+        inline u32 Get(u64 key) { return *Map.Find(key); }
+        inline bool Contains(u64 key) { return Map.Contains(key); }
+        inline void Remove(u64 key) { Map.Remove(key); }
+
+        Heart::HFlatMap<u64, u32> Map;
+    };
+
+    struct StdMapAdapter
+    {
+        inline static constexpr const char* Name = "std::unordered_map";
+
+        inline void Insert(u64 key, u32 value) { Map[key] = value; }
+        inline u32 Get(u64 key) { return Map.find(key)->second; }
+        inline bool Contains(u64 key) { return Map.count(key); }
+        inline void Remove(u64 key) { Map.erase(key); }
+
+        std::unordered_map<u64, u32> Map;
+    };
+
+    template <typename Adapter>
+    std::unique_ptr<Adapter> MakeFilledMap()
+    {
+        auto map = std::make_unique<Adapter>();
+        const auto& keys = GetKeys();
+        for (u32 i = 0; i < KeyCount; i++)
+            map->Insert(keys[i], i);
+        return map;
+    }
+
+    template <typename Adapter>
+    void RegisterMap(Heart::BenchmarkRunner& runner)
+    {
+        using Heart::Benchmark;
+        using Heart::BenchmarkState;
+        auto name = [](const char* benchmark) { return Heart::HString8(Adapter::Name) + " - " + benchmark; };
+
+        // One iteration fills a fresh map with every key
+        runner.Register(name("Insert"), [](BenchmarkState& state)
+        {
+            const auto& keys = GetKeys();
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                Adapter map;
+                for (u32 j = 0; j < KeyCount; j++)
+                    map.Insert(keys[j], j);
+                Benchmark::DoNotOptimize(map);
+            }
+        });
+
+        // The lookups below are one key per iteration against a map of every key. Building and
+        // freeing the map happens with the clock paused
+        runner.Register(name("Find Hits"), [](BenchmarkState& state)
+        {
+            const auto& keys = GetKeys();
+            state.PauseTiming();
+            auto map = MakeFilledMap<Adapter>();
+            state.ResumeTiming();
+
+            u64 sum = 0;
+            for (u64 i = 0; i < state.GetIterations(); i++)
+                sum += map->Get(keys[i & (KeyCount - 1)]);
+            Benchmark::DoNotOptimize(sum);
+
+            state.PauseTiming();
+            map.reset();
+            state.ResumeTiming();
+        });
+
+        runner.Register(name("Find Misses"), [](BenchmarkState& state)
+        {
+            const auto& keys = GetKeys();
+            state.PauseTiming();
+            auto map = MakeFilledMap<Adapter>();
+            state.ResumeTiming();
+
+            u32 found = 0;
+            for (u64 i = 0; i < state.GetIterations(); i++)
+                found += map->Contains(keys[i & (KeyCount - 1)] + 1);
+            HE_ENGINE_ASSERT(found == 0);
+            Benchmark::DoNotOptimize(found);
+
+            state.PauseTiming();
+            map.reset();
+            state.ResumeTiming();
+        });
+
+        // One iteration visits every element
+        runner.Register(name("Iterate"), [](BenchmarkState& state)
+        {
+            state.PauseTiming();
+            auto map = MakeFilledMap<Adapter>();
+            state.ResumeTiming();
+
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                u64 sum = 0;
+                for (auto& pair : map->Map)
+                    sum += pair.second;
+                HE_ENGINE_ASSERT(sum == (u64)KeyCount * (KeyCount - 1) / 2);
+                Benchmark::DoNotOptimize(sum);
+            }
+
+            state.PauseTiming();
+            map.reset();
+            state.ResumeTiming();
+        });
+
+        // One iteration removes every other key from a full map
+        runner.Register(name("Remove"), [](BenchmarkState& state)
+        {
+            const auto& keys = GetKeys();
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                state.PauseTiming();
+                auto map = MakeFilledMap<Adapter>();
+                state.ResumeTiming();
+
+                for (u32 j = 0; j < KeyCount; j += 2)
+                    map->Remove(keys[j]);
+                Benchmark::ClobberMemory();
+
+                state.PauseTiming();
+                map.reset();
+                state.ResumeTiming();
+            }
+        });
+    }
+
+    inline void Register(Heart::BenchmarkRunner& runner)
+    {
+        RegisterMap<FlatMapAdapter>(runner);
+        RegisterMap<StdMapAdapter>(runner);
+    }
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "Heart/Util/Benchmark.h"
+#include "Heart/Container/HVector.hpp"
+
+// One iteration builds or drains a whole container so that growth is part of the measurement
+namespace HVectorBenchmarks
+{
+    struct TestStruct
+    {
+        TestStruct() = default;
+        ~TestStruct()
+        {
+            Field3 = false;
+        }
+
+        u64 Field1 = 12345;
+        f32 Field2 = 12345.f;
+        bool Field3 = true;
+        u64 Field4 = 24680;
+        Heart::HVector<u32> Field5;
+    };
+
+    // Same layout as TestStruct but opted into bytewise relocation
+    struct RelocatableTestStruct : public TestStruct {};
+
+    // Points at itself, so it is only valid if the container runs its move constructor
+    struct SelfPointerStruct
+    {
+        SelfPointerStruct(u32 value = 0)
+            : Value(value), Self(this)
+        {}
+
+        SelfPointerStruct(const SelfPointerStruct& other)
+            : Value(other.Value), Self(this)
+        {}
+
+        SelfPointerStruct(SelfPointerStruct&& other)
+            : Value(other.Value), Self(this)
+        {}
+
+        SelfPointerStruct& operator=(const SelfPointerStruct& other)
+        {
+            Value = other.Value;
+            return *this;
+        }
+
+        inline bool IsValid() const { return Self == this; }
+
+        u32 Value;
+        SelfPointerStruct* Self;
+    };
+}
+
+namespace Heart
+{
+    template <>
+    struct IsTriviallyRelocatable<HVectorBenchmarks::RelocatableTestStruct> : std::true_type {};
+}
+
+namespace HVectorBenchmarks
+{
+    inline void Register(Heart::BenchmarkRunner& runner)
+    {
+        using Heart::Benchmark;
+        using Heart::BenchmarkState;
+        using Heart::HVector;
+
+        constexpr u32 addCount = 100000;
+        constexpr u32 removeCount = 10000;
+
+        runner.Register("HVector - Add", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HVector<TestStruct> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.AddInPlace();
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("std::vector - Add", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                std::vector<TestStruct> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.emplace_back();
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("HVector - Add (trivially relocatable)", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HVector<RelocatableTestStruct> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.AddInPlace();
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("HVector - Add Integers", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HVector<u32> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.Add(j);
+                Benchmark::DoNotOptimize(vec.Data());
+            }
+        });
+
+        runner.Register("std::vector - Add Integers", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                std::vector<u32> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.push_back(j);
+                Benchmark::DoNotOptimize(vec.data());
+            }
+        });
+
+        runner.Register("HVector - Add Self Pointers", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HVector<SelfPointerStruct> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.AddInPlace(j);
+                for (u32 j = 0; j < 100; j++)
+                    vec.Remove(0);
+                for (u32 j = 0; j < 100; j++)
+                    vec.Insert(SelfPointerStruct(j), 0);
+
+                state.PauseTiming();
+                for (auto& elem : vec)
+                    HE_ENGINE_ASSERT(elem.IsValid(), "HVector relocated a non-trivially relocatable type bytewise");
+                state.ResumeTiming();
+            }
+        });
+
+        runner.Register("std::vector - Add Self Pointers", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                std::vector<SelfPointerStruct> vec;
+                for (u32 j = 0; j < addCount; j++)
+                    vec.emplace_back(j);
+                for (u32 j = 0; j < 100; j++)
+                    vec.erase(vec.begin());
+                for (u32 j = 0; j < 100; j++)
+                    vec.insert(vec.begin(), SelfPointerStruct(j));
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("HVector - Remove", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                state.PauseTiming();
+                HVector<TestStruct> vec(removeCount);
+                state.ResumeTiming();
+
+                for (u32 j = 0; j < removeCount; j++)
+                    vec.Remove(0);
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("std::vector - Remove", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                state.PauseTiming();
+                std::vector<TestStruct> vec(removeCount);
+                state.ResumeTiming();
+
+                for (u32 j = 0; j < removeCount; j++)
+                    vec.erase(vec.begin());
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("HVector - Remove (trivially relocatable)", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                state.PauseTiming();
+                HVector<RelocatableTestStruct> vec(removeCount);
+                state.ResumeTiming();
+
+                for (u32 j = 0; j < removeCount; j++)
+                    vec.Remove(0);
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("HVector - Add & Remove", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HVector<TestStruct> vec;
+                for (u32 j = 0; j < 25; j++)
+                {
+                    for (u32 k = 0; k < 2500; k++)
+                        vec.AddInPlace();
+                    for (u32 k = 0; k < 2500; k++)
+                        vec.Remove(0);
+                }
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+
+        runner.Register("std::vector - Add & Remove", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                std::vector<TestStruct> vec;
+                for (u32 j = 0; j < 25; j++)
+                {
+                    for (u32 k = 0; k < 2500; k++)
+                        vec.emplace_back();
+                    for (u32 k = 0; k < 2500; k++)
+                        vec.erase(vec.begin());
+                }
+                Benchmark::DoNotOptimize(vec);
+            }
+        });
+    }
+}
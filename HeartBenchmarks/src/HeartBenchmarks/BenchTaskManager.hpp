@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Heart/Util/Benchmark.h"
+#include "Heart/Task/TaskManager.h"
+
+// Expects the TaskManager to be running. One iteration schedules a batch of tasks and waits for
+// it, keeping at most one batch in flight so that the measurement reflects steady state rather
+// than how many closures can be outstanding at once
+namespace TaskManagerBenchmarks
+{
+    struct LargeCapture
+    {
+        u64 Data[32] = {};
+    };
+
+    inline constexpr u32 BatchSize = 1000;
+
+    // Static since the tasks are never waited on directly and may outlive the benchmark
+    inline static std::atomic<u32> Executed = 0;
+
+    template <typename Func>
+    void ScheduleBatch(Func&& func)
+    {
+        u32 target = Executed.load() + BatchSize;
+        for (u32 i = 0; i < BatchSize; i++)
+            Heart::TaskManager::Schedule(func, Heart::Task::Priority::High, "Benchmark");
+        while (Executed.load() < target)
+            std::this_thread::yield();
+    }
+
+    inline void Register(Heart::BenchmarkRunner& runner)
+    {
+        using Heart::Benchmark;
+        using Heart::BenchmarkState;
+
+        runner.Register("TaskManager - Schedule Small Closures", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+                ScheduleBatch([](){ Executed++; });
+        });
+
+        runner.Register("TaskManager - Schedule Large Closures", [](BenchmarkState& state)
+        {
+            LargeCapture large;
+            for (u64 i = 0; i < state.GetIterations(); i++)
+                ScheduleBatch([large](){ Executed += 1 + (u32)large.Data[0]; });
+        });
+
+        runner.Register("std::function - Construct Large Closures", [](BenchmarkState& state)
+        {
+            LargeCapture large;
+            u32 count = 0;
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                for (u32 j = 0; j < BatchSize; j++)
+                {
+                    std::function<void()> func = [&count, large](){ count += 1 + (u32)large.Data[0]; };
+                    func();
+                }
+            }
+            Benchmark::DoNotOptimize(count);
+        });
+    }
+}
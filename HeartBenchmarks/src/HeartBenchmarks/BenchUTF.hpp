@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Heart/Util/Benchmark.h"
+#include "Heart/Container/HString8.h"
+#include "Heart/Container/HString16.h"
+#include "ww898/utf_converters.hpp"
+
+// Short names like the ones passed through the scripting callbacks, and a long mixed script
+// string. Compared against the previous null terminated conversion
+namespace UTFBenchmarks
+{
+    inline const char16* const Names[] = {
+        u"Player",
+        u"Main Camera",
+        u"Directional Light (1)",
+        u"Spawner_Enemy_Large_042",
+        u"プレイヤー",
+        u"Ünïcödé Nämé"
+    };
+
+    inline std::u16string MakeLongText()
+    {
+        std::u16string text;
+        for (u32 i = 0; i < 200; i++)
+            text += u"Entity text with some 日本語 mixed in. ";
+        return text;
+    }
+
+    inline void Register(Heart::BenchmarkRunner& runner)
+    {
+        using Heart::Benchmark;
+        using Heart::BenchmarkState;
+        using Heart::HString8;
+        using Heart::HString16;
+
+        // One conversion per iteration
+        runner.Register("UTFUtils - Short UTF16 to UTF8", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HString8 str = Heart::HStringView16(Names[i % 6]).ToUTF8();
+                Benchmark::DoNotOptimize(str);
+            }
+        });
+
+        runner.Register("ww898 - Short UTF16 to UTF8", [](BenchmarkState& state)
+        {
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HString8 str = HString8(ww898::utf::convz<char8>(Names[i % 6]));
+                Benchmark::DoNotOptimize(str);
+            }
+        });
+
+        // UTF16 to UTF8 and back per iteration
+        runner.Register("UTFUtils - Long round trip", [](BenchmarkState& state)
+        {
+            state.PauseTiming();
+            HString16 text = MakeLongText();
+            state.ResumeTiming();
+
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HString16 str = text.ToUTF8().ToUTF16();
+                HE_ENGINE_ASSERT(str.Count() == text.Count());
+                Benchmark::DoNotOptimize(str);
+            }
+        });
+
+        runner.Register("ww898 - Long round trip", [](BenchmarkState& state)
+        {
+            state.PauseTiming();
+            HString16 text = MakeLongText();
+            state.ResumeTiming();
+
+            for (u64 i = 0; i < state.GetIterations(); i++)
+            {
+                HString16 str = HString16(ww898::utf::convz<char16>(HString8(ww898::utf::convz<char8>(text.Data())).Data()));
+                HE_ENGINE_ASSERT(str.Count() == text.Count());
+                Benchmark::DoNotOptimize(str);
+            }
+        });
+    }
+}
@@ -0,0 +1,112 @@
+#include "hepch.h"
+
+#include "Heart/Core/Log.h"
+#include "Heart/Util/Benchmark.h"
+#include "Heart/Task/TaskManager.h"
+#include "HeartBenchmarks/BenchHVector.hpp"
+#include "HeartBenchmarks/BenchHArray.hpp"
+#include "HeartBenchmarks/BenchHFlatMap.hpp"
+#include "HeartBenchmarks/BenchUTF.hpp"
+#include "HeartBenchmarks/BenchTaskManager.hpp"
+
+// Replace the global allocation functions so that benchmarks can report allocations per
+// iteration. The array and nothrow forms forward to these by default
+void* operator new(std::size_t size)
+{
+    Heart::Benchmark::RecordAllocation();
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    Heart::Benchmark::RecordAllocation();
+    #ifdef HE_PLATFORM_WINDOWS
+        void* ptr = _aligned_malloc(size ? size : 1, static_cast<std::size_t>(align));
+    #else
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, std::max(static_cast<std::size_t>(align), sizeof(void*)), size ? size : 1))
+            ptr = nullptr;
+    #endif
+    if (ptr)
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#ifdef HE_PLATFORM_WINDOWS
+void operator delete(void* ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+#else
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+#endif
+
+// Usage: Benchmarks [--filter <substring>] [--samples <count>] [--min-time <seconds>]
+//                   [--json <path>] [--csv <path>] [--baseline <path>] [--threshold <fraction>]
+// Exits with 1 if any benchmark regressed against the baseline by more than the threshold
+int main(int argc, char** argv)
+{
+    Heart::Logger::Initialize("Benchmarks");
+
+    Heart::BenchmarkSettings settings;
+    settings.CountAllocations = true;
+    Heart::HString8 filter, jsonPath, csvPath, baselinePath;
+    double threshold = 0.1;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            HE_ENGINE_LOG_ERROR("Missing value for argument '{0}'", arg);
+            return 2;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "--filter")
+            filter = value;
+        else if (arg == "--samples")
+            settings.SampleCount = static_cast<u32>(std::stoul(value));
+        else if (arg == "--min-time")
+            settings.MinSampleSeconds = std::stod(value);
+        else if (arg == "--json")
+            jsonPath = value;
+        else if (arg == "--csv")
+            csvPath = value;
+        else if (arg == "--baseline")
+            baselinePath = value;
+        else if (arg == "--threshold")
+            threshold = std::stod(value);
+        else
+        {
+            HE_ENGINE_LOG_ERROR("Unknown argument '{0}'", arg);
+            return 2;
+        }
+    }
+
+    Heart::TaskManager::Initialize(Heart::TaskManager::WorkerPolicy::LogicalCores);
+
+    Heart::BenchmarkRunner runner(settings);
+    HVectorBenchmarks::Register(runner);
+    HArrayBenchmarks::Register(runner);
+    HFlatMapBenchmarks::Register(runner);
+    UTFBenchmarks::Register(runner);
+    TaskManagerBenchmarks::Register(runner);
+    runner.Run(filter);
+
+    Heart::TaskManager::Shutdown();
+
+    if (!jsonPath.IsEmpty())
+        runner.WriteJson(jsonPath);
+    if (!csvPath.IsEmpty())
+        runner.WriteCsv(csvPath);
+
+    u32 regressions = 0;
+    if (!baselinePath.IsEmpty())
+        regressions = runner.CompareToBaseline(baselinePath, threshold);
+
+    return regressions > 0 ? 1 : 0;
+}
@@ -36,10 +36,10 @@ namespace HeartEditor
             m_ProcessingIds.Add(pair.first);
         }
 
-        bool valid = selectedAsset && UUIDRegistry.find(selectedAsset) != UUIDRegistry.end();
+        auto selectedEntry = selectedAsset ? UUIDRegistry.Find(selectedAsset) : nullptr;
 
         m_Picker.OnImGuiRender(
-            valid ? UUIDRegistry.at(selectedAsset).Path.Data() : selectText.Data(),
+            selectedEntry ? selectedEntry->Path.Data() : selectText.Data(),
             "Select Asset",
             m_ProcessingIds.Count(), 4,
             [this]()
@@ -68,7 +68,7 @@ namespace HeartEditor
             [this](u32 index)
             {
                 Heart::UUID id = m_ProcessingIds[index];
-                auto& entry = Heart::AssetManager::GetUUIDRegistry().at(id);
+                auto& entry = Heart::AssetManager::GetUUIDRegistry().Get(id);
                 Heart::Asset* asset = Heart::AssetManager::RetrieveAsset(id);
 
                 // TODO: previews
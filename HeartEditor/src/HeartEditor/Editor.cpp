@@ -114,7 +114,8 @@ namespace HeartEditor
     void Editor::RenderWindows()
     {
         HE_PROFILE_FUNCTION();
-        auto timer = Heart::AggregateTimer("Editor::RenderWindows");
+        static const Heart::HStringId timerId = "Editor::RenderWindows";
+        auto timer = Heart::AggregateTimer(timerId);
 
         for (auto& pair : s_Windows)
             pair.second->OnImGuiRender();
@@ -123,7 +124,8 @@ namespace HeartEditor
     void Editor::RenderWindowsPostSceneUpdate()
     {
         HE_PROFILE_FUNCTION();
-        auto timer = Heart::AggregateTimer("Editor::RenderWindowsPostSceneUpdate");
+        static const Heart::HStringId timerId = "Editor::RenderWindowsPostSceneUpdate";
+        auto timer = Heart::AggregateTimer(timerId);
 
         for (auto& pair : s_Windows)
             pair.second->OnImGuiRenderPostSceneUpdate();
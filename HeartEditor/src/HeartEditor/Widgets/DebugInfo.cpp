@@ -8,6 +8,10 @@
 #include "Heart/Core/Timing.h"
 #include "Heart/Renderer/SceneRenderer.h"
 #include "Heart/Renderer/RenderPlugin.h"
+#include "Heart/Task/TaskManager.h"
+#include "Heart/Task/JobManager.h"
+#include "Heart/Task/TaskTelemetry.h"
+#include "Heart/Util/FilesystemUtils.h"
 #include "Flourish/Api/Context.h"
 #include "imgui/imgui.h"
 
@@ -53,6 +57,38 @@ namespace Widgets
             ImGui::Text("%s: %.1fms", pair.first.Data(), Heart::AggregateTimer::GetAggregateTime(pair.first));
         ImGui::Unindent();
 
+        ImGui::Text("Task Queues:");
+        ImGui::Indent();
+        ImGui::Text("High: %d", Heart::TaskManager::GetQueueDepth(Heart::Task::Priority::High));
+        ImGui::Text("Medium: %d", Heart::TaskManager::GetQueueDepth(Heart::Task::Priority::Medium));
+        ImGui::Text("Low: %d", Heart::TaskManager::GetQueueDepth(Heart::Task::Priority::Low));
+        ImGui::Text("Main Thread: %d", Heart::TaskManager::GetMainThreadBacklog());
+        ImGui::Unindent();
+
+        ImGui::Text("Job Imbalance: %.2f", Heart::JobManager::GetAverageImbalance());
+
+        ImGui::Text("Task Telemetry:");
+        ImGui::Indent();
+        auto& taskStats = Heart::TaskTelemetry::GetFrameStats();
+        ImGui::Text("Tasks: %d", (int)taskStats.TasksExecuted);
+        ImGui::Text("Steals: %d", (int)taskStats.Steals);
+        ImGui::Text("Avg Latency: %.1fus", taskStats.AverageLatency);
+        ImGui::Text("Avg Run Time: %.1fus", taskStats.AverageRunTime);
+        ImGui::Text("Worker Utilization: %.0f%%", taskStats.Utilization * 100.0);
+        if (ImGui::Button("Export Trace"))
+        {
+            Heart::HString8 path = Heart::FilesystemUtils::SaveAsDialog(
+                "",
+                "Export Task Trace",
+                "TaskTrace",
+                "json",
+                "json"
+            );
+            if (!path.IsEmpty())
+                Heart::TaskTelemetry::WriteChromeTrace(path, 120);
+        }
+        ImGui::Unindent();
+
         ImGui::Text("GPU Memory:");
         ImGui::Indent();
         Flourish::MemoryStatistics memoryStats = Flourish::Context::ComputeMemoryStatistics();
@@ -790,7 +790,7 @@ namespace Widgets
             } break;
             case Heart::Variant::Type::String:
             {
-                Heart::HString intermediate = value.String().Convert(Heart::HString::Encoding::UTF8);
+                Heart::HString intermediate = value.StringView().Convert(Heart::HString::Encoding::UTF8);
                 if (Heart::ImGuiUtils::InputText(widgetId.DataUTF8(), intermediate))
                 {
                     instance->SetFieldValue(fieldName, intermediate.Convert(Heart::HString::Encoding::UTF16), true);
@@ -99,7 +99,7 @@ namespace Widgets
         ImGui::PopStyleVar();
     }
 
-    void RenderGraph::RenderNode(const Heart::HString8& pluginName, Heart::GraphDependencyType depType)
+    void RenderGraph::RenderNode(Heart::HStringId pluginName, Heart::GraphDependencyType depType)
     {
         auto plugin = m_RendererContext->GetPlugin(pluginName);
         const auto& graphData = plugin->GetGraphData(depType);
@@ -17,7 +17,7 @@ namespace Widgets
         void OnImGuiRender() override;
 
     private:
-        void RenderNode(const Heart::HString8& pluginName, Heart::GraphDependencyType depType);
+        void RenderNode(Heart::HStringId pluginName, Heart::GraphDependencyType depType);
 
     private:
         ax::NodeEditor::EditorContext* m_EditorContext;
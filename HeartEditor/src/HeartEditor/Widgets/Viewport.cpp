@@ -73,7 +73,7 @@ namespace Widgets
         auto& plugins = m_SceneRenderer->GetPlugins();
         const Flourish::Texture* outputTex = nullptr;
         u32 outputLayer = 0;
-        if (m_SelectedOutput.first == "")
+        if (m_SelectedOutput.first.IsEmpty())
             outputTex = m_SceneRenderer->GetOutputTexture().get();
         else
             outputTex = plugins.at(m_SelectedOutput.first)->GetDebugTextures().at(m_SelectedOutput.second).get();
@@ -196,8 +196,8 @@ namespace Widgets
         ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(5.f, 5.f));
         if (ImGui::BeginPopup("OutSel"))
         {
-            if (ImGui::MenuItem("Primary", nullptr, m_SelectedOutput.first == ""))
-                m_SelectedOutput.first = "";
+            if (ImGui::MenuItem("Primary", nullptr, m_SelectedOutput.first.IsEmpty()))
+                m_SelectedOutput.first = Heart::HStringId();
             for (auto& pair : plugins)
             {
                 const auto& debugTextures = pair.second->GetDebugTextures();
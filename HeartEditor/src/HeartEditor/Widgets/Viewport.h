@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Heart/Task/Task.h"
+#include "Heart/Container/HStringId.h"
 #include "HeartEditor/Widgets/Widget.h"
 #include "imgui/imgui.h"
 #include "imguizmo/ImGuizmo.h"
@@ -67,7 +68,7 @@ namespace Widgets
         f32 m_AspectRatio = 1.f;
         ImGuizmo::MODE m_GizmoMode = ImGuizmo::MODE::LOCAL;
         ImGuizmo::OPERATION m_GizmoOperation = ImGuizmo::OPERATION::TRANSLATE;
-        std::pair<Heart::HString8, Heart::HString8> m_SelectedOutput = { "", "" };
+        std::pair<Heart::HStringId, Heart::HString8> m_SelectedOutput = { Heart::HStringId(), "" };
         int m_SelectedOutputMip = 0;
     };
 }
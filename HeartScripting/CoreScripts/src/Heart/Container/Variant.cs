@@ -30,11 +30,15 @@ namespace Heart.Container
             // 'Any' mem fields
             [FieldOffset(0)] public HStringInternal String;
             [FieldOffset(0)] public HArrayInternal Array;
+            [FieldOffset(0)] public fixed byte InlineString[16];
         }
 
         // There is some hidden padding going on, so we also
         // alignas(8) in the native variant struct
         [FieldOffset(0)] private VariantType _type;
+        [FieldOffset(1)] private byte _inlineString;
+        [FieldOffset(2)] private Encoding _inlineEncoding;
+        [FieldOffset(3)] private byte _inlineCount;
         [FieldOffset(8)] private Data _data;
 
         public void Dispose()
@@ -48,6 +52,9 @@ namespace Heart.Container
                 case VariantType.UInt:
                 case VariantType.Float:
                     return;
+                case VariantType.String:
+                    if (IsStringInline) return;
+                    break;
             }
 
             Native_Variant_Destroy(this);
@@ -93,12 +100,30 @@ namespace Heart.Container
             set { _data.Float = value; _type = VariantType.Float; }
         }
 
+        // Short strings are stored directly in the variant by native code, in which case String
+        // is not valid and InlineStringToString must be used instead
+        public bool IsStringInline
+        {
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            get => _inlineString != 0;
+        }
+
         public HStringInternal String
         {
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
             get => _data.String;
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
-            set { _data.String = value; _type = VariantType.String; }
+            set { _data.String = value; _type = VariantType.String; _inlineString = 0; }
+        }
+
+        public unsafe string InlineStringToString()
+        {
+            fixed (byte* ptr = _data.InlineString)
+            {
+                if (_inlineEncoding == Encoding.UTF8)
+                    return System.Text.Encoding.UTF8.GetString(ptr, _inlineCount);
+                return new string((char*)ptr, 0, _inlineCount);
+            }
         }
 
         public HArrayInternal Array
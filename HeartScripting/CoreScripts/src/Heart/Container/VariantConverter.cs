@@ -63,7 +63,9 @@ namespace Heart.Container
                 case VariantType.Float:
                     return variant.Float;
                 case VariantType.String:
-                    return NativeMarshal.HStringInternalToString(variant.String);
+                    return variant.IsStringInline
+                        ? variant.InlineStringToString()
+                        : NativeMarshal.HStringInternalToString(variant.String);
                 case VariantType.Array:
                     return new HArray(variant.Array);
             }
@@ -59,7 +59,7 @@ namespace Heart.Scene
             => throw new InvalidOperationException("Cannot remove a children component");
 
         [UnmanagedCallback]
-        internal static unsafe partial void Native_ChildrenComponent_Get(uint entityHandle, IntPtr sceneHandle, out UUID* comp);
+        internal static unsafe partial void Native_ChildrenComponent_Get(uint entityHandle, IntPtr sceneHandle, out UUID* data, out uint count);
 
         [UnmanagedCallback]
         internal static partial void Native_ChildrenComponent_AddChild(uint entityHandle, IntPtr sceneHandle, UUID uuid);
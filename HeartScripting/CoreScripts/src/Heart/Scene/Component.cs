@@ -47,10 +47,6 @@ namespace Heart.Scene
 
     public static class ComponentUtils
     {
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        internal static unsafe ContainerInfo* GetInfoFromPtr<T>(T* ptr) where T : unmanaged
-            => (ContainerInfo*)ptr - 1;
-
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public static unsafe UUID GetId(uint entityHandle, IntPtr sceneHandle)
         {
@@ -84,8 +80,8 @@ namespace Heart.Scene
 
         public static unsafe UUID GetChildId(uint entityHandle, IntPtr sceneHandle, uint index)
         {
-            ChildrenComponent.Native_ChildrenComponent_Get(entityHandle, sceneHandle, out var arr);
-            if (arr == null) return 0;
+            ChildrenComponent.Native_ChildrenComponent_Get(entityHandle, sceneHandle, out var arr, out var count);
+            if (index >= count) return 0;
             return arr[index];
         }
 
@@ -99,9 +95,9 @@ namespace Heart.Scene
 
         public static unsafe UUID[] GetChildrenIds(uint entityHandle, IntPtr sceneHandle)
         {
-            ChildrenComponent.Native_ChildrenComponent_Get(entityHandle, sceneHandle, out var arr);
-            if (arr == null) return new UUID[0];
-            return NativeMarshal.PtrToArray(arr, GetInfoFromPtr(arr)->ElemCount);
+            ChildrenComponent.Native_ChildrenComponent_Get(entityHandle, sceneHandle, out var arr, out var count);
+            if (count == 0) return new UUID[0];
+            return NativeMarshal.PtrToArray(arr, count);
         }
 
         public static unsafe Entity[] GetChildren(uint entityHandle, IntPtr sceneHandle)
@@ -112,9 +108,8 @@ namespace Heart.Scene
 
         public static unsafe uint GetChildrenCount(uint entityHandle, IntPtr sceneHandle)
         {
-            ChildrenComponent.Native_ChildrenComponent_Get(entityHandle, sceneHandle, out var arr);
-            if (arr == null) return 0;
-            return GetInfoFromPtr(arr)->ElemCount;
+            ChildrenComponent.Native_ChildrenComponent_Get(entityHandle, sceneHandle, out _, out var count);
+            return count;
         }
 
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -7,15 +7,12 @@ using System.Runtime.InteropServices;
 
 namespace Heart.Scene
 {
-    [StructLayout(LayoutKind.Explicit, Size = 16)]
+    // Materials are stored in a small vector whose layout depends on its size, so they are
+    // accessed through Native_MeshComponent_GetMaterials instead
+    [StructLayout(LayoutKind.Explicit, Size = 48)]
     internal unsafe struct MeshComponentInternal
     {
         [FieldOffset(0)] public UUID Mesh;
-        [FieldOffset(8)] public UUID* Materials;
-
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        public ContainerInfo* GetMaterialInfo()
-            => (ContainerInfo*)Materials - 1;
     }
 
     public partial class MeshComponent : IComponent
@@ -53,37 +50,37 @@ namespace Heart.Scene
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
             get
             {
-                RefreshPtr();
-                return _internalValue->GetMaterialInfo()->ElemCount;
+                Native_MeshComponent_GetMaterials(_entityHandle, _sceneHandle, out _, out var count);
+                return count;
             }
         }
 
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public unsafe UUID GetMaterial(uint index)
         {
-            RefreshPtr();
-            return _internalValue->Materials[index];
+            Native_MeshComponent_GetMaterials(_entityHandle, _sceneHandle, out var materials, out _);
+            return materials[index];
         }
 
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public unsafe UUID[] GetMaterials(uint index)
         {
-            RefreshPtr();
-            return NativeMarshal.PtrToArray(_internalValue->Materials, _internalValue->GetMaterialInfo()->ElemCount);
+            Native_MeshComponent_GetMaterials(_entityHandle, _sceneHandle, out var materials, out var count);
+            return NativeMarshal.PtrToArray(materials, count);
         }
 
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public unsafe void SetMaterial(uint index, UUID material)
         {
-            RefreshPtr();
-            _internalValue->Materials[index] = material;
+            Native_MeshComponent_GetMaterials(_entityHandle, _sceneHandle, out var materials, out _);
+            materials[index] = material;
         }
 
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public unsafe void SetMaterials(UUID[] materials)
         {
-            RefreshPtr();
-            NativeMarshal.CopyArrayToPtr(materials, _internalValue->Materials, _internalValue->GetMaterialInfo()->ElemCount);
+            Native_MeshComponent_GetMaterials(_entityHandle, _sceneHandle, out var data, out var count);
+            NativeMarshal.CopyArrayToPtr(materials, data, count);
         }
 
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -128,6 +125,9 @@ namespace Heart.Scene
         [UnmanagedCallback]
         internal static partial void Native_MeshComponent_Remove(uint entityHandle, IntPtr sceneHandle);
 
+        [UnmanagedCallback]
+        internal static unsafe partial void Native_MeshComponent_GetMaterials(uint entityHandle, IntPtr sceneHandle, out UUID* data, out uint count);
+
         [UnmanagedCallback]
         internal static partial void Native_MeshComponent_AddMaterial(uint entityHandle, IntPtr sceneHandle, UUID material);
 
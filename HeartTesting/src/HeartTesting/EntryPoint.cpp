@@ -1,6 +1,25 @@
 #include "hepch.h"
 
-#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_IMPLEMENT
 #include "doctest/doctest.h"
 
-#include "HeartTesting/TestHVector.hpp"
\ No newline at end of file
+#include "Heart/Core/Log.h"
+#include "HeartTesting/TestHVector.hpp"
+#include "HeartTesting/TestHFrozenVector.hpp"
+#include "HeartTesting/TestHSmallVector.hpp"
+#include "HeartTesting/TestFrameArena.hpp"
+#include "HeartTesting/TestHStringId.hpp"
+#include "HeartTesting/TestHFlatMap.hpp"
+#include "HeartTesting/TestUTFUtils.hpp"
+#include "HeartTesting/TestVariant.hpp"
+#include "HeartTesting/TestConcurrentQueues.hpp"
+#include "HeartTesting/TestScheduler.hpp"
+
+int main(int argc, char** argv)
+{
+    // Parts of the engine under test log, i.e. the scheduler when it detects the CPU topology
+    Heart::Logger::Initialize("Tests");
+
+    doctest::Context context(argc, argv);
+    return context.run();
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/HSpscQueue.hpp"
+#include "Heart/Container/HMpmcQueue.hpp"
+#include "Heart/Container/HMpscQueue.hpp"
+#include "Heart/Container/HString8.h"
+#include "Heart/Container/HVector.hpp"
+
+// Encodes which producer pushed a value so consumers can check per producer ordering
+inline u64 MakeQueueValue(u32 producer, u32 index) { return ((u64)producer << 32) | index; }
+
+TEST_CASE("Testing HSpscQueue")
+{
+    SUBCASE("Push and pop")
+    {
+        Heart::HSpscQueue<u32> queue(4);
+        CHECK(queue.GetCapacity() == 4);
+
+        u32 value = 0;
+        CHECK_FALSE(queue.Pop(value));
+        for (u32 i = 0; i < 4; i++)
+            CHECK(queue.Push(i));
+        CHECK_FALSE(queue.Push(4));
+        CHECK(queue.CountApprox() == 4);
+
+        bool ordered = true;
+        for (u32 i = 0; i < 4; i++)
+            ordered &= queue.Pop(value) && value == i;
+        CHECK(ordered);
+        CHECK(queue.IsEmptyApprox());
+    }
+    SUBCASE("Non trivial elements")
+    {
+        // Elements left in the queue are destroyed with it
+        Heart::HSpscQueue<Heart::HString8> queue(8);
+        for (u32 i = 0; i < 20; i++)
+        {
+            queue.Push(Heart::HString8(std::to_string(i)));
+            if (i % 3 == 0)
+            {
+                Heart::HString8 str;
+                queue.Pop(str);
+            }
+        }
+
+        Heart::HString8 front;
+        CHECK(queue.Pop(front));
+        CHECK(front == "7");
+    }
+    SUBCASE("Contention")
+    {
+        // Small capacity so that both sides constantly run into full and empty
+        constexpr u32 count = 1000000;
+        Heart::HSpscQueue<u64> queue(64);
+        std::thread producer([&queue]()
+        {
+            for (u32 i = 0; i < count; i++)
+                while (!queue.Push(i))
+                    std::this_thread::yield();
+        });
+
+        bool ordered = true;
+        u64 value = 0;
+        for (u32 i = 0; i < count; i++)
+        {
+            while (!queue.Pop(value))
+                std::this_thread::yield();
+            ordered &= value == i;
+        }
+        producer.join();
+
+        CHECK(ordered);
+        CHECK_FALSE(queue.Pop(value));
+    }
+}
+
+TEST_CASE("Testing HMpmcQueue")
+{
+    SUBCASE("Push and pop")
+    {
+        Heart::HMpmcQueue<Heart::HString8> queue(3);
+        CHECK(queue.GetCapacity() == 4);
+
+        for (u32 i = 0; i < 4; i++)
+            CHECK(queue.Push(Heart::HString8(std::to_string(i))));
+        CHECK_FALSE(queue.Emplace("4"));
+
+        // Wrap around a few laps
+        bool ordered = true;
+        Heart::HString8 value;
+        for (u32 i = 4; i < 40; i++)
+        {
+            ordered &= queue.Pop(value) && value == Heart::HString8(std::to_string(i - 4));
+            ordered &= queue.Emplace(std::to_string(i));
+        }
+        CHECK(ordered);
+        CHECK(queue.CountApprox() == 4);
+    }
+    SUBCASE("Contention")
+    {
+        constexpr u32 producerCount = 4;
+        constexpr u32 consumerCount = 4;
+        constexpr u32 countPerProducer = 200000;
+        Heart::HMpmcQueue<u64> queue(128);
+
+        std::atomic<u32> consumed = 0;
+        Heart::HVector<Heart::HVector<u64>> received;
+        received.Resize(consumerCount);
+
+        Heart::HVector<std::thread> threads;
+        for (u32 i = 0; i < producerCount; i++)
+        {
+            threads.AddInPlace([&queue, i]()
+            {
+                for (u32 j = 0; j < countPerProducer; j++)
+                    while (!queue.Push(MakeQueueValue(i, j)))
+                        std::this_thread::yield();
+            });
+        }
+        for (u32 i = 0; i < consumerCount; i++)
+        {
+            threads.AddInPlace([&queue, &consumed, &received, i]()
+            {
+                u64 value;
+                while (consumed.load() < producerCount * countPerProducer)
+                {
+                    if (!queue.Pop(value))
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    received[i].Add(value);
+                    consumed++;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        threads.Clear(true);
+
+        // Every value arrives exactly once, and each consumer sees each producer's values in order
+        Heart::HVector<u8> seen;
+        seen.Resize(producerCount * countPerProducer);
+        bool ordered = true;
+        bool unique = true;
+        for (auto& values : received)
+        {
+            s64 last[producerCount];
+            std::fill(last, last + producerCount, -1);
+            for (u64 value : values)
+            {
+                u32 producer = (u32)(value >> 32);
+                u32 index = (u32)value;
+                ordered &= (s64)index > last[producer];
+                last[producer] = index;
+                unique &= seen[producer * countPerProducer + index]++ == 0;
+            }
+        }
+        CHECK(ordered);
+        CHECK(unique);
+        CHECK(consumed.load() == producerCount * countPerProducer);
+        CHECK(queue.IsEmptyApprox());
+    }
+}
+
+TEST_CASE("Testing HMpscQueue")
+{
+    SUBCASE("Push and pop")
+    {
+        // Small segments so that a few are linked and freed
+        Heart::HMpscQueue<Heart::HString8, 4> queue;
+
+        Heart::HString8 value;
+        CHECK_FALSE(queue.Pop(value));
+        for (u32 i = 0; i < 50; i++)
+            queue.Push(Heart::HString8(std::to_string(i)));
+
+        bool ordered = true;
+        for (u32 i = 0; i < 30; i++)
+            ordered &= queue.Pop(value) && value == Heart::HString8(std::to_string(i));
+        CHECK(ordered);
+
+        u32 next = 30;
+        u32 drained = queue.Drain([&ordered, &next](Heart::HString8& str)
+        {
+            ordered &= str == Heart::HString8(std::to_string(next++));
+        });
+        CHECK(ordered);
+        CHECK(drained == 20);
+        CHECK_FALSE(queue.Pop(value));
+
+        // Leave some behind for the destructor
+        queue.Emplace("left");
+        queue.Emplace("behind");
+    }
+    SUBCASE("Contention")
+    {
+        constexpr u32 producerCount = 6;
+        constexpr u32 countPerProducer = 100000;
+        Heart::HMpscQueue<u64, 64> queue;
+
+        Heart::HVector<std::thread> threads;
+        for (u32 i = 0; i < producerCount; i++)
+        {
+            threads.AddInPlace([&queue, i]()
+            {
+                for (u32 j = 0; j < countPerProducer; j++)
+                    queue.Push(MakeQueueValue(i, j));
+            });
+        }
+
+        // Consume while producing so that segments are retired under contention
+        u32 next[producerCount] = {};
+        bool ordered = true;
+        u32 consumed = 0;
+        u64 value;
+        while (consumed < producerCount * countPerProducer)
+        {
+            if (!queue.Pop(value))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            u32 producer = (u32)(value >> 32);
+            ordered &= (u32)value == next[producer]++;
+            consumed++;
+        }
+        for (auto& thread : threads)
+            thread.join();
+        threads.Clear(true);
+
+        CHECK(ordered);
+        CHECK_FALSE(queue.Pop(value));
+    }
+}
@@ -0,0 +1,225 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/FrameArena.h"
+
+TEST_CASE("Testing FrameArena")
+{
+    Heart::FrameArena::Initialize(2, 1024);
+
+    REQUIRE(Heart::FrameArena::GetFrameCount() == 2);
+    REQUIRE(Heart::FrameArena::GetBytesUsed() == 0);
+
+    SUBCASE("Allocate")
+    {
+        void* a = Heart::FrameArena::Allocate(24, 8);
+        void* b = Heart::FrameArena::Allocate(1, 64);
+        u32* c = Heart::FrameArena::Allocate<u32>(4);
+
+        CHECK(a != b);
+        CHECK(reinterpret_cast<uintptr_t>(a) % 8 == 0);
+        CHECK(reinterpret_cast<uintptr_t>(b) % 64 == 0);
+        CHECK(reinterpret_cast<uintptr_t>(c) % alignof(u32) == 0);
+        CHECK(Heart::FrameArena::GetBytesUsed() > 0);
+        CHECK(Heart::FrameArena::GetOverflowCount() == 0);
+    }
+    SUBCASE("Reset")
+    {
+        void* first = Heart::FrameArena::Allocate(64, 16);
+        u64 frame = Heart::FrameArena::GetFrameNumber();
+
+        Heart::FrameArena::BeginFrame();
+
+        CHECK(Heart::FrameArena::GetFrameNumber() == frame + 1);
+        CHECK(Heart::FrameArena::GetBytesUsed() == 0);
+
+        // The first arena comes back around once every in flight frame has passed
+        Heart::FrameArena::BeginFrame();
+
+        CHECK(Heart::FrameArena::Allocate(64, 16) == first);
+    }
+    SUBCASE("Overflow")
+    {
+        for (u32 i = 0; i < 4; i++)
+            Heart::FrameArena::Allocate(512, 1);
+
+        CHECK(Heart::FrameArena::GetOverflowCount() > 0);
+        CHECK(Heart::FrameArena::GetBytesUsed() >= 2048);
+
+        // The arena grows to fit the next time it is used
+        Heart::FrameArena::BeginFrame();
+        Heart::FrameArena::BeginFrame();
+        for (u32 i = 0; i < 4; i++)
+            Heart::FrameArena::Allocate(512, 1);
+
+        CHECK(Heart::FrameArena::GetOverflowCount() == 0);
+    }
+    SUBCASE("Allocate across threads")
+    {
+        // Every thread writes its index into each of its allocations, which would get clobbered if
+        // two allocations overlapped. Plenty of them overflow the tiny arena as well
+        Heart::HVector<std::thread> threads;
+        Heart::HVector<Heart::HVector<u32*>> allocations;
+        allocations.Resize(4);
+        for (u32 i = 0; i < 4; i++)
+        {
+            threads.AddInPlace([i, &allocations]()
+            {
+                for (u32 j = 0; j < 1000; j++)
+                {
+                    u32* data = Heart::FrameArena::Allocate<u32>(4);
+                    for (u32 k = 0; k < 4; k++)
+                        data[k] = i;
+                    allocations[i].Add(data);
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        threads.Clear(true);
+
+        bool matches = true;
+        for (u32 i = 0; i < 4; i++)
+            for (u32* data : allocations[i])
+                for (u32 k = 0; k < 4; k++)
+                    matches &= data[k] == i;
+        CHECK(matches);
+        CHECK(Heart::FrameArena::GetBytesUsed() >= 4 * 1000 * 4 * sizeof(u32));
+    }
+
+    Heart::FrameArena::Shutdown();
+}
+
+TEST_CASE("Testing FrameVector")
+{
+    Heart::FrameArena::Initialize(2, 1024);
+
+    Heart::FrameVector<u32> vTest;
+
+    SUBCASE("Add")
+    {
+        for (u32 i = 0; i < 100; i++)
+            vTest.Add(i);
+
+        CHECK(vTest.Count() == 100);
+        CHECK(vTest.GetAllocatedCount() >= 100);
+        CHECK(vTest.Front() == 0);
+        CHECK(vTest.Back() == 99);
+
+        bool matches = true;
+        for (u32 i = 0; i < 100; i++)
+            matches &= vTest[i] == i;
+        CHECK(matches);
+    }
+    SUBCASE("Add from self")
+    {
+        while (vTest.Count() < vTest.GetAllocatedCount() || vTest.IsEmpty())
+            vTest.Add(5);
+        vTest.Add(vTest.Front());
+
+        CHECK(vTest.Back() == 5);
+    }
+    SUBCASE("Resize")
+    {
+        vTest.Add(5);
+        vTest.Resize(20);
+
+        CHECK(vTest.Count() == 20);
+        CHECK(vTest.Front() == 5);
+        CHECK(vTest.Back() == 0);
+    }
+    SUBCASE("Pop")
+    {
+        vTest.Add(1);
+        vTest.Add(2);
+        vTest.Pop();
+
+        CHECK(vTest.Count() == 1);
+        CHECK(vTest.Back() == 1);
+
+        vTest.Pop();
+        CHECK_THROWS_AS(vTest.Pop(), std::out_of_range);
+    }
+    SUBCASE("Clear")
+    {
+        vTest.Add(1);
+        u32* data = vTest.Data();
+        vTest.Clear();
+
+        // Storage is kept for the rest of the frame
+        CHECK(vTest.IsEmpty());
+        CHECK(vTest.Data() == data);
+
+        // But dropped afterwards since the arena it came from will be reset
+        Heart::FrameArena::BeginFrame();
+        vTest.Clear();
+
+        CHECK(vTest.Data() == nullptr);
+        CHECK(vTest.GetAllocatedCount() == 0);
+    }
+
+    Heart::FrameArena::Shutdown();
+}
+
+TEST_CASE("Testing FrameHashMap")
+{
+    Heart::FrameArena::Initialize(2, 1024);
+
+    Heart::FrameHashMap<u64, u32> mTest;
+
+    SUBCASE("Insert and find")
+    {
+        for (u64 i = 0; i < 1000; i++)
+            mTest[i * 4096] = (u32)i;
+
+        CHECK(mTest.Count() == 1000);
+
+        bool matches = true;
+        for (u64 i = 0; i < 1000; i++)
+        {
+            u32* value = mTest.Find(i * 4096);
+            matches &= value && *value == i;
+        }
+        CHECK(matches);
+        CHECK_FALSE(mTest.Contains(1));
+        CHECK(mTest.Find(4095) == nullptr);
+    }
+    SUBCASE("Existing key")
+    {
+        mTest[7] = 1;
+        mTest[7]++;
+
+        CHECK(mTest.Count() == 1);
+        CHECK(mTest[7] == 2);
+    }
+    SUBCASE("Iteration order")
+    {
+        mTest[30] = 0;
+        mTest[10] = 1;
+        mTest[20] = 2;
+
+        u32 index = 0;
+        bool matches = true;
+        for (auto& entry : mTest)
+            matches &= entry.Value == index++;
+        CHECK(matches);
+        CHECK(index == 3);
+    }
+    SUBCASE("Clear")
+    {
+        mTest[1] = 1;
+        mTest.Clear();
+
+        CHECK(mTest.IsEmpty());
+        CHECK_FALSE(mTest.Contains(1));
+
+        Heart::FrameArena::BeginFrame();
+        mTest.Clear();
+        mTest[2] = 2;
+
+        CHECK(mTest.Count() == 1);
+        CHECK(mTest[2] == 2);
+    }
+
+    Heart::FrameArena::Shutdown();
+}
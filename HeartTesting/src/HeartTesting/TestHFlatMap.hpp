@@ -0,0 +1,187 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/HFlatMap.hpp"
+#include "Heart/Container/HFlatSet.hpp"
+#include "Heart/Container/HString8.h"
+
+// Sends many keys to the same bucket so that probing and backward shifting get exercised
+struct CollidingHash
+{
+    size_t operator()(u64 key) const { return key % 4; }
+};
+
+TEST_CASE("Testing HFlatMap")
+{
+    Heart::HFlatMap<u64, u32> mTest;
+
+    SUBCASE("Insert and find")
+    {
+        for (u64 i = 0; i < 1000; i++)
+            mTest[i * 4096] = (u32)i;
+
+        CHECK(mTest.Count() == 1000);
+
+        bool matches = true;
+        for (u64 i = 0; i < 1000; i++)
+        {
+            u32* value = mTest.Find(i * 4096);
+            matches &= value && *value == i;
+        }
+        CHECK(matches);
+        CHECK_FALSE(mTest.Contains(1));
+        CHECK(mTest.Find(4095) == nullptr);
+        CHECK(mTest.Get(4096) == 1);
+    }
+    SUBCASE("Insert existing")
+    {
+        CHECK(mTest.Insert(7, 1));
+        CHECK_FALSE(mTest.Insert(7, 2));
+
+        CHECK(mTest.Count() == 1);
+        CHECK(mTest[7] == 1);
+    }
+    SUBCASE("Remove")
+    {
+        for (u64 i = 0; i < 100; i++)
+            mTest[i] = (u32)i;
+
+        CHECK(mTest.Remove(50));
+        CHECK_FALSE(mTest.Remove(50));
+        CHECK_FALSE(mTest.Contains(50));
+        CHECK(mTest.Count() == 99);
+        CHECK(mTest.Get(99) == 99);
+    }
+    SUBCASE("Remove with collisions")
+    {
+        Heart::HFlatMap<u64, u32, CollidingHash> colliding;
+        for (u64 i = 0; i < 200; i++)
+            colliding[i] = (u32)i;
+        for (u64 i = 0; i < 200; i += 3)
+            colliding.Remove(i);
+
+        bool matches = true;
+        for (u64 i = 0; i < 200; i++)
+        {
+            u32* value = colliding.Find(i);
+            matches &= (i % 3 == 0) ? value == nullptr : value && *value == i;
+        }
+        CHECK(matches);
+        CHECK(colliding.Count() == 133);
+    }
+    SUBCASE("Matches std::unordered_map")
+    {
+        // Random mix of inserts and removes on a small key range so that buckets are constantly
+        // filled and emptied
+        std::unordered_map<u64, u32> reference;
+        u64 state = 12345;
+        for (u32 i = 0; i < 20000; i++)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            u64 key = (state >> 33) % 512;
+            if ((state >> 20) & 1)
+            {
+                mTest[key] = i;
+                reference[key] = i;
+            }
+            else
+                CHECK(mTest.Remove(key) == (reference.erase(key) == 1));
+        }
+
+        CHECK(mTest.Count() == reference.size());
+        bool matches = true;
+        for (auto& pair : reference)
+        {
+            u32* value = mTest.Find(pair.first);
+            matches &= value && *value == pair.second;
+        }
+        for (auto& pair : mTest)
+            matches &= reference.count(pair.first) == 1;
+        CHECK(matches);
+    }
+    SUBCASE("Iterate")
+    {
+        CHECK(mTest.Begin() == mTest.End());
+
+        mTest[30] = 3;
+        mTest[10] = 1;
+        mTest[20] = 2;
+
+        u32 count = 0;
+        bool matches = true;
+        for (auto& [key, value] : mTest)
+        {
+            matches &= key == value * 10;
+            value++;
+            count++;
+        }
+        CHECK(matches);
+        CHECK(count == 3);
+        CHECK(mTest[10] == 2);
+    }
+    SUBCASE("Reserve")
+    {
+        mTest.Reserve(1000);
+        u32 bucketCount = mTest.GetBucketCount();
+        for (u64 i = 0; i < 1000; i++)
+            mTest[i] = (u32)i;
+
+        CHECK(mTest.GetBucketCount() == bucketCount);
+    }
+    SUBCASE("Clear")
+    {
+        mTest[1] = 1;
+        mTest.Clear();
+
+        CHECK(mTest.IsEmpty());
+        CHECK_FALSE(mTest.Contains(1));
+
+        mTest[2] = 2;
+        CHECK(mTest.Count() == 1);
+
+        mTest.Clear(true);
+        CHECK(mTest.GetBucketCount() == 0);
+        CHECK(mTest.Find(2) == nullptr);
+    }
+    SUBCASE("Copy")
+    {
+        mTest[1] = 1;
+        Heart::HFlatMap<u64, u32> mTest2 = mTest;
+        mTest2[1] = 2;
+        mTest2[3] = 3;
+
+        CHECK(mTest[1] == 1);
+        CHECK(mTest.Count() == 1);
+        CHECK(mTest2.Count() == 2);
+    }
+    SUBCASE("Non trivial values")
+    {
+        Heart::HFlatMap<Heart::HString8, Heart::HString8> strings;
+        for (u32 i = 0; i < 100; i++)
+            strings[Heart::HString8(std::to_string(i))] = Heart::HString8(std::to_string(i * 2));
+        for (u32 i = 0; i < 100; i += 2)
+            strings.Remove(Heart::HString8(std::to_string(i)));
+
+        CHECK(strings.Count() == 50);
+        CHECK(strings.Get("7") == "14");
+        CHECK_FALSE(strings.Contains("8"));
+    }
+}
+
+TEST_CASE("Testing HFlatSet")
+{
+    Heart::HFlatSet<u32> sTest = { 1, 2, 3 };
+
+    CHECK(sTest.Count() == 3);
+    CHECK(sTest.Contains(2));
+    CHECK_FALSE(sTest.Insert(2));
+    CHECK(sTest.Insert(4));
+    CHECK(sTest.Remove(1));
+    CHECK_FALSE(sTest.Contains(1));
+    CHECK(sTest.Count() == 3);
+
+    u32 sum = 0;
+    for (u32 key : sTest)
+        sum += key;
+    CHECK(sum == 9);
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/HFrozenVector.hpp"
+#include "HeartTesting/DataStruct.hpp"
+
+TEST_CASE("Testing HFrozenVector")
+{
+    Heart::HVector<DataStruct> vData = {
+        DataStruct(1),
+        DataStruct(2),
+        DataStruct(3)
+    };
+
+    DataStructsAllocated = 0;
+    DataStructsDeallocated = 0;
+
+    SUBCASE("Construct from copy")
+    {
+        Heart::HFrozenVector<DataStruct> fTest(vData);
+
+        CHECK(fTest.Count() == vData.Count());
+        CHECK(fTest.Data() != vData.Data());
+        CHECK(fTest.GetRefCount() == 1);
+        CHECK(fTest.Front().GetRefCount() == 2);
+        CHECK(DataStructsAllocated == 0);
+    }
+    SUBCASE("Construct from move")
+    {
+        void* oldData = vData.Data();
+        Heart::HFrozenVector<DataStruct> fTest(std::move(vData));
+
+        CHECK(fTest.Count() == 3);
+        CHECK(fTest.Data() == oldData);
+        CHECK(fTest.Front().GetRefCount() == 1);
+        CHECK(vData.Data() == nullptr);
+        CHECK(vData.Count() == 0);
+    }
+    SUBCASE("Copies share")
+    {
+        Heart::HFrozenVector<DataStruct> fTest(std::move(vData));
+        Heart::HFrozenVector<DataStruct> fTest2 = fTest;
+        Heart::HFrozenVector<DataStruct> fTest3;
+        fTest3 = fTest2;
+
+        CHECK(fTest2.Data() == fTest.Data());
+        CHECK(fTest3.Data() == fTest.Data());
+        CHECK(fTest.GetRefCount() == 3);
+        CHECK(fTest.Front().GetRefCount() == 1);
+        CHECK(DataStructsDeallocated == 0);
+    }
+    SUBCASE("Thaw")
+    {
+        Heart::HFrozenVector<DataStruct> fTest(std::move(vData));
+        Heart::HVector<DataStruct> vTest = fTest.Thaw();
+        vTest.Add(DataStruct(4));
+
+        CHECK(vTest.Data() != fTest.Data());
+        CHECK(vTest.Count() == 4);
+        CHECK(fTest.Count() == 3);
+        CHECK(fTest.GetRefCount() == 1);
+        CHECK(fTest.Front().GetRefCount() == 2);
+    }
+    SUBCASE("Shared across threads")
+    {
+        Heart::HFrozenVector<DataStruct> fTest(std::move(vData));
+
+        // Every thread copies and releases the buffer many times over
+        Heart::HVector<std::thread> threads;
+        std::atomic<u32> mismatches = 0;
+        for (u32 i = 0; i < 4; i++)
+        {
+            threads.AddInPlace([fTest, &mismatches]()
+            {
+                for (u32 j = 0; j < 10000; j++)
+                {
+                    Heart::HFrozenVector<DataStruct> copy = fTest;
+                    if (copy.Back().Value != 3)
+                        mismatches++;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        threads.Clear(true);
+
+        CHECK(mismatches == 0);
+        CHECK(fTest.GetRefCount() == 1);
+        CHECK(DataStructsDeallocated == 0);
+    }
+}
+
+TEST_CASE("Testing HVector copy on write")
+{
+    Heart::HVector<DataStruct> vData = {
+        DataStruct(1),
+        DataStruct(2),
+        DataStruct(3)
+    };
+    Heart::HVector<DataStruct> vTest;
+    vTest.ShallowCopy(vData);
+
+    DataStructsAllocated = 0;
+    DataStructsDeallocated = 0;
+
+    REQUIRE(vTest.IsShared());
+    REQUIRE(vTest.Data() == vData.Data());
+
+    SUBCASE("Add")
+    {
+        vTest.Add(DataStruct(4));
+
+        CHECK(vTest.Data() != vData.Data());
+        CHECK_FALSE(vTest.IsShared());
+        CHECK_FALSE(vData.IsShared());
+        CHECK(vTest.Count() == 4);
+        CHECK(vData.Count() == 3);
+        CHECK(vTest.Front() == vData.Front());
+        CHECK(vData.Front().GetRefCount() == 2);
+    }
+    SUBCASE("Remove")
+    {
+        vTest.Remove(0);
+
+        CHECK(vTest.Count() == 2);
+        CHECK(vData.Count() == 3);
+        CHECK(vData.Front().Value == 1);
+        CHECK(vTest.Front().Value == 2);
+        CHECK(DataStructsDeallocated == 0);
+    }
+    SUBCASE("Pop")
+    {
+        vTest.Pop();
+
+        CHECK(vTest.Count() == 2);
+        CHECK(vData.Count() == 3);
+        CHECK(vData.Back().GetRefCount() == 1);
+    }
+    SUBCASE("Clear")
+    {
+        vTest.Clear();
+
+        CHECK(vTest.IsEmpty());
+        CHECK(vData.Count() == 3);
+        CHECK_FALSE(vData.IsShared());
+        CHECK(vData.Front().GetRefCount() == 1);
+        CHECK(DataStructsDeallocated == 0);
+    }
+    SUBCASE("MakeUnique")
+    {
+        vTest.MakeUnique();
+        vTest[0].Value = 10;
+
+        CHECK(vTest.Data() != vData.Data());
+        CHECK(vData.Front().Value == 1);
+        CHECK(DataStructsAllocated == 0);
+    }
+}
@@ -0,0 +1,262 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/HSmallVector.hpp"
+#include "Heart/Container/HVector.hpp"
+#include "HeartTesting/DataStruct.hpp"
+
+TEST_CASE("Testing HSmallVector")
+{
+    Heart::HSmallVector<DataStruct, 4> vData = {
+        DataStruct(1),
+        DataStruct(2),
+        DataStruct(3)
+    };
+    Heart::HSmallVector<DataStruct, 4> vTest;
+
+    DataStructsAllocated = 0;
+    DataStructsDeallocated = 0;
+
+    REQUIRE(vData.Count() == 3);
+    REQUIRE(vData.IsInline());
+    REQUIRE(vTest.IsInline());
+    REQUIRE(vTest.IsEmpty());
+    REQUIRE(vTest.Count() == 0);
+    REQUIRE(vTest.GetAllocatedCount() == 4);
+
+    SUBCASE("Copy constructor")
+    {
+        Heart::HSmallVector<DataStruct, 4> vTest2(vData);
+
+        CHECK(vTest2.Count() == vData.Count());
+        CHECK(vTest2.Data() != vData.Data()); // ensure copy
+        CHECK(vTest2.IsInline());
+        CHECK(vTest2.Front() == vData.Front());
+        CHECK(vTest2.Back() == vData.Back());
+        CHECK(vTest2.Front().GetRefCount() == 2);
+        CHECK(DataStructsAllocated == 0);
+    }
+    SUBCASE("ElemCount constructor (fill = false)")
+    {
+        Heart::HSmallVector<DataStruct, 4> vTest2(8, false);
+
+        CHECK(vTest2.Count() == 0);
+        CHECK(vTest2.GetAllocatedCount() >= 8);
+        CHECK_FALSE(vTest2.IsInline());
+        CHECK(DataStructsAllocated == 0);
+    }
+    SUBCASE("ElemCount constructor (fill = true)")
+    {
+        Heart::HSmallVector<DataStruct, 4> vTest2(3, true);
+
+        CHECK(vTest2.Count() == 3);
+        CHECK(vTest2.IsInline());
+        CHECK(vTest2.Front().GetRefCount() == 1);
+        CHECK(DataStructsAllocated == 3);
+    }
+    SUBCASE("Add")
+    {
+        vTest.Add(DataStruct(1));
+        vTest.Add(DataStruct(2));
+
+        void* inlineData = vTest.Data();
+        CHECK(vTest.Count() == 2);
+        CHECK(vTest.IsInline());
+        CHECK(vTest.Front().Value == 1);
+        CHECK(vTest.Back().Value == 2);
+        CHECK(DataStructsAllocated == 2);
+
+        while (vTest.Count() < 4)
+            vTest.Add(DataStruct(3));
+
+        CHECK(vTest.IsInline());
+        CHECK(vTest.Data() == inlineData);
+
+        vTest.Add(DataStruct(4));
+
+        CHECK(vTest.Count() == 5);
+        CHECK_FALSE(vTest.IsInline());
+        CHECK(vTest.Data() != inlineData); // spilled onto the heap
+        CHECK(vTest.GetAllocatedCount() >= 5);
+        CHECK(vTest.Front().Value == 1);
+        CHECK(vTest[3].Value == 3);
+        CHECK(vTest.Back().Value == 4);
+        CHECK(vTest.Front().GetRefCount() == 1);
+        CHECK(DataStructsAllocated == 5);
+        CHECK(DataStructsDeallocated == 0);
+    }
+    SUBCASE("Add from self")
+    {
+        vData.Add(DataStruct(4));
+        vData.Add(vData.Front());
+
+        CHECK(vData.Count() == 5);
+        CHECK_FALSE(vData.IsInline());
+        CHECK(vData.Back() == vData.Front());
+        CHECK(vData.Front().GetRefCount() == 2);
+    }
+    SUBCASE("Remove")
+    {
+        vData.Remove(0);
+
+        CHECK(vData.Count() == 2);
+        CHECK(vData.Front().Value == 2);
+        CHECK(vData.Back().Value == 3);
+        CHECK(DataStructsDeallocated == 1);
+
+        CHECK_THROWS_AS(vData.Remove(2), std::out_of_range);
+    }
+    SUBCASE("Remove unordered")
+    {
+        vData.RemoveUnordered(0);
+
+        CHECK(vData.Count() == 2);
+        CHECK(vData.Front().Value == 3);
+        CHECK(vData.Back().Value == 2);
+        CHECK(DataStructsDeallocated == 1);
+
+        CHECK_THROWS_AS(vData.RemoveUnordered(2), std::out_of_range);
+    }
+    SUBCASE("Pop")
+    {
+        vData.Pop();
+
+        CHECK(vData.Count() == 2);
+        CHECK(vData.Back().Value == 2);
+        CHECK(DataStructsDeallocated == 1);
+
+        vData.Pop();
+        vData.Pop();
+
+        CHECK(vData.IsEmpty());
+        CHECK_THROWS_AS(vData.Pop(), std::out_of_range);
+    }
+    SUBCASE("Insert - beginning")
+    {
+        vData.Insert(DataStruct(5), 0);
+        vData.Insert(DataStruct(4), 0);
+
+        CHECK(vData.Count() == 5);
+        CHECK_FALSE(vData.IsInline());
+        CHECK(vData[0].Value == 4);
+        CHECK(vData[1].Value == 5);
+        CHECK(vData[2].Value == 1);
+        CHECK(vData.Back().Value == 3);
+    }
+    SUBCASE("Insert - middle")
+    {
+        vData.Insert(DataStruct(4), 1);
+
+        CHECK(vData.Count() == 4);
+        CHECK(vData.IsInline());
+        CHECK(vData[0].Value == 1);
+        CHECK(vData[1].Value == 4);
+        CHECK(vData[2].Value == 2);
+        CHECK(vData.Back().Value == 3);
+    }
+    SUBCASE("Append")
+    {
+        Heart::HSmallVector<DataStruct, 4> vTest2 = { DataStruct(4) };
+        vTest2.Append(vData);
+
+        CHECK(vTest2.Count() == 4);
+        CHECK(vTest2.IsInline());
+        CHECK(vTest2.Front().Value == 4);
+        CHECK(vTest2.Back() == vData.Back());
+        CHECK(vTest2.Back().GetRefCount() == 2);
+
+        vTest2.Append(vData);
+
+        CHECK(vTest2.Count() == 7);
+        CHECK_FALSE(vTest2.IsInline());
+        CHECK(vTest2.Back() == vData.Back());
+        CHECK(vTest2.Back().GetRefCount() == 3);
+    }
+    SUBCASE("Clear (shrink = true)")
+    {
+        vData.Reserve(16);
+        CHECK_FALSE(vData.IsInline());
+        CHECK(vData.Front().Value == 1);
+
+        vData.Clear(true);
+
+        CHECK(vData.IsEmpty());
+        CHECK(vData.IsInline());
+        CHECK(vData.GetAllocatedCount() == 4);
+        CHECK(DataStructsDeallocated == 3);
+    }
+    SUBCASE("Resize")
+    {
+        vTest.Resize(6, true);
+
+        CHECK(vTest.Count() == 6);
+        CHECK_FALSE(vTest.IsInline());
+        CHECK(DataStructsAllocated == 6);
+
+        vTest.Resize(2, true);
+
+        CHECK(vTest.Count() == 2);
+        CHECK(DataStructsDeallocated == 4);
+    }
+    SUBCASE("Move constructor (inline)")
+    {
+        Heart::HSmallVector<DataStruct, 4> vTest2(std::move(vData));
+
+        CHECK(vTest2.Count() == 3);
+        CHECK(vTest2.IsInline());
+        CHECK(vTest2.Back().Value == 3);
+        CHECK(vTest2.Front().GetRefCount() == 1);
+        CHECK(vData.IsEmpty());
+        CHECK(DataStructsAllocated == 0);
+        CHECK(DataStructsDeallocated == 0);
+    }
+    SUBCASE("Move assignment (heap)")
+    {
+        vData.Add(DataStruct(4));
+        vData.Add(DataStruct(5));
+        void* heapData = vData.Data();
+
+        vTest = std::move(vData);
+
+        CHECK(vTest.Count() == 5);
+        CHECK(vTest.Data() == heapData);
+        CHECK(vTest.Back().Value == 5);
+        CHECK(vData.IsEmpty());
+        CHECK(vData.IsInline());
+    }
+    SUBCASE("Assignment operator")
+    {
+        vTest = vData;
+
+        CHECK(vTest.Count() == vData.Count());
+        CHECK(vTest.Data() != vData.Data());
+        CHECK(vTest.Front() == vData.Front());
+        CHECK(vTest.Front().GetRefCount() == 2);
+        CHECK(DataStructsAllocated == 0);
+    }
+    SUBCASE("Relocated by HVector")
+    {
+        // Inline vectors must survive being memcpy'd when the outer vector grows
+        Heart::HVector<Heart::HSmallVector<u32, 2>> outer;
+        for (u32 i = 0; i < 64; i++)
+        {
+            outer.AddInPlace();
+            outer.Back().Add(i);
+            if (i % 2 == 0)
+            {
+                outer.Back().Add(i + 1);
+                outer.Back().Add(i + 2);
+            }
+        }
+
+        bool matches = true;
+        for (u32 i = 0; i < 64; i++)
+        {
+            matches &= outer[i].Front() == i;
+            matches &= outer[i].IsInline() == (i % 2 != 0);
+            if (i % 2 == 0)
+                matches &= outer[i].Back() == i + 2;
+        }
+        CHECK(matches);
+    }
+}
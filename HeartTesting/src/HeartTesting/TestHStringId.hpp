@@ -0,0 +1,86 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/HStringId.h"
+#include "Heart/Container/HVector.hpp"
+
+TEST_CASE("Testing HStringId")
+{
+    Heart::HStringId idTest("TestHStringId");
+
+    REQUIRE_FALSE(idTest.IsEmpty());
+    REQUIRE(idTest.GetString() == "TestHStringId");
+
+    SUBCASE("Same string")
+    {
+        Heart::HString8 str = "TestHStringId";
+        Heart::HStringId idTest2(str);
+
+        CHECK(idTest2 == idTest);
+        CHECK(idTest2.GetHash() == idTest.GetHash());
+        CHECK(idTest2.Data() == idTest.Data()); // stored once
+    }
+    SUBCASE("Different string")
+    {
+        Heart::HStringId idTest2("TestHStringId2");
+
+        CHECK(idTest2 != idTest);
+        CHECK(idTest2.Count() == 14);
+        CHECK(idTest < idTest2);
+    }
+    SUBCASE("Empty")
+    {
+        Heart::HStringId idTest2;
+        Heart::HStringId idTest3("");
+
+        CHECK(idTest2.IsEmpty());
+        CHECK(idTest3 == idTest2);
+        CHECK(idTest2.GetString().IsEmpty());
+    }
+    SUBCASE("Find")
+    {
+        u32 internedCount = Heart::HStringId::GetInternedCount();
+
+        CHECK(Heart::HStringId::Find("TestHStringId") == idTest);
+        CHECK(Heart::HStringId::Find("TestHStringIdNeverInterned").IsEmpty());
+        CHECK(Heart::HStringId::GetInternedCount() == internedCount);
+    }
+    SUBCASE("Hash map key")
+    {
+        std::unordered_map<Heart::HStringId, u32> map;
+        map[idTest] = 1;
+        map["TestHStringIdKey"] = 2;
+
+        CHECK(map.at(Heart::HString8("TestHStringId")) == 1);
+        CHECK(map.at("TestHStringIdKey") == 2);
+    }
+    SUBCASE("Interned across threads")
+    {
+        // Every thread interns the same strings in a different order and must agree on the ids
+        Heart::HVector<std::thread> threads;
+        Heart::HVector<Heart::HVector<Heart::HStringId>> results;
+        results.Resize(4);
+        for (u32 i = 0; i < 4; i++)
+        {
+            threads.AddInPlace([i, &results]()
+            {
+                results[i].Resize(2000, false);
+                for (u32 j = 0; j < 2000; j++)
+                {
+                    u32 index = (j + i * 500) % 2000;
+                    results[i][index] = Heart::HStringId(Heart::HString8(std::to_string(index) + "TestHStringIdThreads"));
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        threads.Clear(true);
+
+        bool matches = true;
+        for (u32 i = 1; i < 4; i++)
+            for (u32 j = 0; j < 2000; j++)
+                matches &= results[i][j] == results[0][j];
+        CHECK(matches);
+        CHECK(results[0][10].GetString() == "10TestHStringIdThreads");
+    }
+}
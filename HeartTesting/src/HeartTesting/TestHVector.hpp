@@ -463,4 +463,41 @@ TEST_CASE("Testing HVector")
         CHECK(DataStructsAllocated == 0);
         CHECK(DataStructsDeallocated == 0);
     }
+    SUBCASE("Relocation")
+    {
+        // Not trivially relocatable, so every move must go through its constructor
+        struct SelfPointer
+        {
+            SelfPointer(u32 value = 0) : Value(value), Self(this) {}
+            SelfPointer(const SelfPointer& other) : Value(other.Value), Self(this) {}
+
+            u32 Value;
+            SelfPointer* Self;
+        };
+
+        Heart::HVector<SelfPointer> vSelf;
+        for (u32 i = 0; i < Heart::Container<SelfPointer>::MinimumAllocCount * 4; i++)
+            vSelf.AddInPlace(i);
+        vSelf.Insert(SelfPointer(100), 0);
+        vSelf.Remove(1);
+        vSelf.RemoveUnordered(2);
+        vSelf.Add(vSelf.Front());
+
+        bool valid = true;
+        for (auto& elem : vSelf)
+            valid &= elem.Self == &elem;
+        CHECK(valid);
+        CHECK(vSelf.Front().Value == 100);
+        CHECK(vSelf[1].Value == 1);
+        CHECK(vSelf.Back().Value == 100);
+
+        // Adding an element of the vector to itself while it grows
+        for (u32 i = 0; i < Heart::Container<DataStruct>::MinimumAllocCount; i++)
+            vData.Add(vData.Front());
+
+        CHECK(vData.Front().GetRefCount() == Heart::Container<DataStruct>::MinimumAllocCount + 1);
+        CHECK(vData.Back() == vData.Front());
+        CHECK(DataStructsAllocated == 0);
+        CHECK(DataStructsDeallocated == 0);
+    }
 }
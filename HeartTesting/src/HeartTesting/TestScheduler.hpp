@@ -0,0 +1,318 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Task/TaskManager.h"
+#include "Heart/Task/JobManager.h"
+#include "nlohmann/json.hpp"
+
+// Every benchmark runs once per worker count from 1 to N, restarting the pool in between, and
+// prints one JSON object per result so that runs can be compared by scripts. Setting
+// HE_BENCHMARK_OUTPUT additionally writes all of the results to that file
+namespace SchedulerTests
+{
+    inline static nlohmann::json BenchmarkResults = nlohmann::json::array();
+
+    struct ScopedWorkers
+    {
+        ScopedWorkers(u32 count)
+        {
+            Heart::TaskManager::Initialize(count);
+            Heart::JobManager::Initialize();
+        }
+
+        ~ScopedWorkers()
+        {
+            Heart::JobManager::Shutdown();
+            Heart::TaskManager::Shutdown();
+        }
+    };
+
+    // Powers of two up to one worker per hardware thread besides the one running the tests
+    inline Heart::HVector<u32> GetWorkerCounts()
+    {
+        u32 maxWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        Heart::HVector<u32> counts;
+        for (u32 count = 1; count < maxWorkers; count *= 2)
+            counts.Add(count);
+        counts.Add(maxWorkers);
+
+        return counts;
+    }
+
+    // Best of a few runs in nanoseconds per unit of work. Every task handle must be released by the
+    // time run returns since the pool is torn down afterwards
+    template<typename Func>
+    void Benchmark(const char* name, u32 units, Func&& run)
+    {
+        double baseline = 0.0;
+        for (u32 workers : GetWorkerCounts())
+        {
+            ScopedWorkers scope(workers);
+
+            double best = std::numeric_limits<double>::max();
+            for (u32 i = 0; i < 3; i++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                run();
+                double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                best = std::min(best, elapsed / units);
+            }
+            if (baseline == 0.0)
+                baseline = best;
+
+            nlohmann::json result = {
+                { "benchmark", name },
+                { "workers", workers },
+                { "units", units },
+                { "nsPerTask", best },
+                { "speedup", baseline / best }
+            };
+            std::cout << result.dump() << std::endl;
+            BenchmarkResults.push_back(result);
+        }
+
+        if (const char* path = std::getenv("HE_BENCHMARK_OUTPUT"))
+        {
+            std::ofstream file(path);
+            file << BenchmarkResults.dump(4);
+        }
+    }
+
+    // Every task spawns its children and waits on them from inside the pool
+    inline void SpawnTree(u32 depth, u32 branching, std::atomic<u32>& visited)
+    {
+        visited++;
+        if (depth == 0) return;
+
+        Heart::TaskGroup children;
+        for (u32 i = 0; i < branching; i++)
+            children.AddTask(Heart::TaskManager::Schedule(
+                [depth, branching, &visited]() { SpawnTree(depth - 1, branching, visited); },
+                Heart::Task::Priority::Medium
+            ));
+        children.Wait();
+    }
+}
+
+TEST_SUITE("Scheduler")
+{
+    TEST_CASE("Empty task throughput")
+    {
+        constexpr u32 taskCount = 100000;
+        SchedulerTests::Benchmark("EmptyTasks", taskCount, [&]()
+        {
+            Heart::TaskGroup group;
+            for (u32 i = 0; i < taskCount; i++)
+                group.AddTask(Heart::TaskManager::Schedule([](){}, Heart::Task::Priority::Medium));
+
+            REQUIRE(group.Wait());
+            CHECK(group.GetTasks().Back().GetStatus() == Heart::Task::Status::Succeeded);
+        });
+    }
+
+    TEST_CASE("Deep dependency chain")
+    {
+        constexpr u32 taskCount = 20000;
+        SchedulerTests::Benchmark("DependencyChain", taskCount, [&]()
+        {
+            std::atomic<u32> next = 0;
+            std::atomic<bool> outOfOrder = false;
+            Heart::Task previous;
+            for (u32 i = 0; i < taskCount; i++)
+            {
+                previous = Heart::TaskManager::Schedule(
+                    [i, &next, &outOfOrder]()
+                    {
+                        if (next.load() != i)
+                            outOfOrder = true;
+                        next++;
+                    },
+                    Heart::Task::Priority::Medium,
+                    previous
+                );
+            }
+
+            REQUIRE(previous.Wait());
+            CHECK(next == taskCount);
+            CHECK_FALSE(outOfOrder);
+        });
+    }
+
+    TEST_CASE("Wide fan-out and fan-in")
+    {
+        constexpr u32 taskCount = 50000;
+        SchedulerTests::Benchmark("FanOutFanIn", taskCount, [&]()
+        {
+            std::atomic<u32> completed = 0;
+            std::atomic<bool> rootDone = false;
+            std::atomic<bool> joinedEarly = false;
+
+            Heart::Task root = Heart::TaskManager::Schedule([&rootDone]() { rootDone = true; }, Heart::Task::Priority::Medium);
+            Heart::TaskGroup children;
+            for (u32 i = 0; i < taskCount; i++)
+            {
+                children.AddTask(Heart::TaskManager::Schedule(
+                    [&]()
+                    {
+                        if (!rootDone) joinedEarly = true;
+                        completed++;
+                    },
+                    Heart::Task::Priority::Medium,
+                    root
+                ));
+            }
+
+            u32 seen = 0;
+            Heart::Task join = Heart::TaskManager::Schedule(
+                [&]() { seen = completed.load(); },
+                Heart::Task::Priority::Medium,
+                children
+            );
+
+            REQUIRE(join.Wait());
+            CHECK(seen == taskCount);
+            CHECK_FALSE(joinedEarly);
+        });
+    }
+
+    TEST_CASE("Nested scheduling")
+    {
+        // 4^0 + 4^1 + ... + 4^7 tasks
+        constexpr u32 depth = 7;
+        constexpr u32 branching = 4;
+        constexpr u32 taskCount = 21845;
+        SchedulerTests::Benchmark("NestedScheduling", taskCount, [&]()
+        {
+            std::atomic<u32> visited = 0;
+            Heart::Task root = Heart::TaskManager::Schedule(
+                [&visited]() { SchedulerTests::SpawnTree(depth, branching, visited); },
+                Heart::Task::Priority::Medium
+            );
+
+            REQUIRE(root.Wait());
+            CHECK(visited == taskCount);
+        });
+    }
+
+    TEST_CASE("ScheduleIter over a large range")
+    {
+        constexpr u32 count = 50000;
+        Heart::HVector<u32> values;
+        for (u32 i = 0; i < count; i++)
+            values.Add(i);
+        u64 expected = (u64)count * (count - 1) / 2;
+
+        SchedulerTests::Benchmark("TaskScheduleIter", count, [&]()
+        {
+            std::atomic<u64> sum = 0;
+            Heart::TaskGroup group = Heart::TaskManager::ScheduleIter(
+                [&sum](u32 value) { sum += value; },
+                values.begin(),
+                values.end(),
+                Heart::TaskGroup()
+            );
+
+            REQUIRE(group.Wait());
+            CHECK(sum == expected);
+        });
+
+        SchedulerTests::Benchmark("JobScheduleIter", count, [&]()
+        {
+            std::atomic<u64> sum = 0;
+            Heart::Job job = Heart::JobManager::ScheduleIter(
+                values.begin(),
+                values.end(),
+                [&sum](size_t index) { sum += index; }
+            );
+
+            REQUIRE(job.Wait());
+            CHECK(sum == expected);
+        });
+    }
+
+    TEST_CASE("Concurrent Wait")
+    {
+        constexpr u32 taskCount = 20000;
+        constexpr u32 waiterCount = 4;
+        SchedulerTests::Benchmark("ConcurrentWait", taskCount, [&]()
+        {
+            std::atomic<u32> completed = 0;
+            Heart::TaskGroup group;
+            for (u32 i = 0; i < taskCount; i++)
+                group.AddTask(Heart::TaskManager::Schedule([&completed]() { completed++; }, Heart::Task::Priority::Medium));
+
+            // Waiters outside of the pool help run the tasks they are waiting on
+            std::atomic<u32> failedWaits = 0;
+            Heart::HVector<std::thread> waiters;
+            for (u32 i = 0; i < waiterCount; i++)
+                waiters.AddInPlace([&group, &failedWaits]() { if (!group.Wait()) failedWaits++; });
+            for (auto& waiter : waiters)
+                waiter.join();
+
+            CHECK(failedWaits == 0);
+            CHECK(completed == taskCount);
+        });
+    }
+
+    TEST_CASE("Queue depth tracks claims")
+    {
+        SchedulerTests::ScopedWorkers scope(1);
+
+        // Keep the only worker busy so that no queue entries get popped during the checks
+        std::atomic<bool> started = false;
+        std::atomic<bool> release = false;
+        Heart::Task blocker = Heart::TaskManager::Schedule(
+            [&]() { started = true; while (!release) std::this_thread::yield(); },
+            Heart::Task::Priority::High
+        );
+        while (!started)
+            std::this_thread::yield();
+
+        // Both tasks get claimed here while their entries are still sitting in the queue
+        Heart::Task cancelled = Heart::TaskManager::Schedule([](){}, Heart::Task::Priority::Low);
+        Heart::Task waited = Heart::TaskManager::Schedule([](){}, Heart::Task::Priority::Low);
+        CHECK(Heart::TaskManager::GetQueueDepth(Heart::Task::Priority::Low) == 2);
+
+        cancelled.Cancel();
+        CHECK(Heart::TaskManager::GetQueueDepth(Heart::Task::Priority::Low) == 1);
+
+        CHECK(waited.Wait());
+        CHECK(Heart::TaskManager::GetQueueDepth(Heart::Task::Priority::Low) == 0);
+
+        release = true;
+        CHECK(blocker.Wait());
+    }
+
+    TEST_CASE("Job exceptions")
+    {
+        SchedulerTests::ScopedWorkers scope(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+        // Every chunk is still accounted for, so the wait returns instead of blocking forever
+        std::atomic<u32> executed = 0;
+        Heart::Job job = Heart::JobManager::ParallelFor(0, 10000, 1, [&executed](size_t index)
+        {
+            if (index == 5000)
+                throw std::runtime_error("Job failure");
+            executed++;
+        });
+        CHECK_THROWS_AS(job.Wait(), std::runtime_error);
+        CHECK(executed < 10000);
+
+        // Every waiter sees the exception
+        CHECK_THROWS_AS(job.Wait(), std::runtime_error);
+
+        CHECK_THROWS_AS(
+            Heart::JobManager::ParallelReduce<u64>(0, 10000, 16, 0, [](size_t index) -> u64
+            {
+                if (index == 9999)
+                    throw std::runtime_error("Reduce failure");
+                return index;
+            }),
+            std::runtime_error
+        );
+
+        // The pool keeps working afterwards
+        u64 sum = Heart::JobManager::ParallelReduce<u64>(0, 10000, 16, 0, [](size_t index) { return (u64)index; });
+        CHECK(sum == 10000ull * 9999 / 2);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/HString.h"
+#include "Heart/Container/HString8.h"
+#include "Heart/Container/HString16.h"
+#include "Heart/Util/UTFUtils.h"
+
+TEST_CASE("Testing UTFUtils")
+{
+    SUBCASE("ASCII")
+    {
+        // Long enough to go through the SIMD blocks and the scalar tail
+        std::string ascii;
+        std::u16string asciiWide;
+        for (u32 i = 0; i < 203; i++)
+        {
+            ascii += (char8)('!' + i % 90);
+            asciiWide += (char16)('!' + i % 90);
+        }
+
+        CHECK(Heart::HString8(ascii).ToUTF16() == Heart::HString16(asciiWide));
+        CHECK(Heart::HString16(asciiWide).ToUTF8() == Heart::HString8(ascii));
+        CHECK(Heart::UTFUtils::IsValidUTF8(ascii.data(), (u32)ascii.size()));
+    }
+    SUBCASE("Multibyte")
+    {
+        Heart::HString8 utf8 = u8"héllo 世界 \U0001F600!";
+        Heart::HString16 utf16 = u"héllo 世界 \U0001F600!";
+
+        CHECK(utf8.ToUTF16() == utf16);
+        CHECK(utf16.ToUTF8() == utf8);
+        CHECK(Heart::UTFUtils::GetUTF16Length(utf8.Data(), utf8.Count()) == utf16.Count());
+        CHECK(Heart::UTFUtils::GetUTF8Length(utf16.Data(), utf16.Count()) == utf8.Count());
+        CHECK(Heart::UTFUtils::IsValidUTF8(utf8.Data(), utf8.Count()));
+        CHECK(Heart::UTFUtils::IsValidUTF16(utf16.Data(), utf16.Count()));
+    }
+    SUBCASE("Mixed blocks")
+    {
+        // Non ASCII characters landing at every offset of the SIMD blocks
+        std::string utf8;
+        std::u16string utf16;
+        for (u32 i = 0; i < 64; i++)
+        {
+            for (u32 j = 0; j < i % 19; j++)
+            {
+                utf8 += 'a';
+                utf16 += u'a';
+            }
+            utf8 += i % 3 == 0 ? u8"é" : (i % 3 == 1 ? u8"世" : u8"\U0001F600");
+            utf16 += i % 3 == 0 ? u"é" : (i % 3 == 1 ? u"世" : u"\U0001F600");
+        }
+        for (u32 i = 0; i < 40; i++)
+        {
+            utf8 += u8"Ж世";
+            utf16 += u"Ж世";
+        }
+
+        CHECK(Heart::HString8(utf8).ToUTF16() == Heart::HString16(utf16));
+        CHECK(Heart::HString16(utf16).ToUTF8() == Heart::HString8(utf8));
+        CHECK(Heart::UTFUtils::GetUTF8Length(utf16.data(), (u32)utf16.size()) == utf8.size());
+    }
+    SUBCASE("Invalid UTF8")
+    {
+        // Overlong, surrogate and truncated sequences each become replacement characters
+        Heart::HStringView8 invalid = "a\xC0\xAF" "b\xED\xA0\x80" "c\xE2\x82";
+        Heart::HString16 converted = invalid.ToUTF16();
+
+        CHECK_FALSE(Heart::UTFUtils::IsValidUTF8(invalid.Data(), invalid.Count()));
+        CHECK(converted == Heart::HString16(u"a��b���c�"));
+        CHECK(Heart::UTFUtils::GetUTF16Length(invalid.Data(), invalid.Count()) == converted.Count());
+    }
+    SUBCASE("Invalid UTF16")
+    {
+        const char16 invalid[] = { u'a', 0xD800, u'b', 0xDC00, 0xD83D };
+        Heart::HString8 converted = Heart::HStringView16(invalid, 5).ToUTF8();
+
+        CHECK_FALSE(Heart::UTFUtils::IsValidUTF16(invalid, 5));
+        CHECK(converted == Heart::HString8(u8"a�b��"));
+        CHECK(Heart::UTFUtils::GetUTF8Length(invalid, 5) == converted.Count());
+    }
+    SUBCASE("Views")
+    {
+        // Only the viewed characters are converted, regardless of where the terminator is
+        Heart::HStringView16 view(u"viewé not included", 5);
+        Heart::HString8 converted = view.ToUTF8();
+
+        CHECK(converted == Heart::HString8(u8"viewé"));
+        CHECK(converted.Data()[converted.Count()] == '\0');
+        CHECK(Heart::HStringView8("abcdef", 3).ToUTF16() == Heart::HString16(u"abc"));
+    }
+    SUBCASE("HString")
+    {
+        Heart::HString utf8 = u8"世界";
+        Heart::HString utf16 = utf8.Convert(Heart::HString::Encoding::UTF16);
+
+        CHECK(utf16.GetEncoding() == Heart::HString::Encoding::UTF16);
+        CHECK(utf16.Count() == 2);
+        CHECK(utf16.Convert(Heart::HString::Encoding::UTF8) == utf8);
+        CHECK(Heart::HStringView(utf16).ToUTF8() == Heart::HString8(u8"世界"));
+        CHECK(utf8.ToUTF16() == Heart::HString16(u"世界"));
+    }
+    SUBCASE("Empty")
+    {
+        CHECK(Heart::HString8().ToUTF16().IsEmpty());
+        CHECK(Heart::HString16(u"").ToUTF8().IsEmpty());
+        CHECK(Heart::UTFUtils::GetUTF16Length("", 0) == 0);
+    }
+}
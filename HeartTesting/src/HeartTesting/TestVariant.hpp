@@ -0,0 +1,102 @@
+#pragma once
+#include "doctest/doctest.h"
+
+#include "Heart/Container/Variant.h"
+#include "Heart/Container/HArray.h"
+#include "Heart/Container/HString.h"
+
+TEST_CASE("Testing Variant")
+{
+    SUBCASE("Scalars")
+    {
+        CHECK(Heart::Variant(true).Bool());
+        CHECK(Heart::Variant((s32)-5).Int() == -5);
+        CHECK(Heart::Variant((u64)5).UInt() == 5);
+        CHECK(Heart::Variant(0.5).Float() == 0.5);
+        CHECK(Heart::Variant().GetType() == Heart::Variant::Type::None);
+    }
+    SUBCASE("Inline strings")
+    {
+        // 15 UTF8 or 7 UTF16 characters fit inline along with the terminator
+        Heart::Variant utf8(Heart::HStringView("fifteen chars!!"));
+        Heart::Variant utf16(Heart::HStringView(u"seven!!"));
+
+        CHECK(utf8.GetType() == Heart::Variant::Type::String);
+        CHECK(utf8.IsStringInline());
+        CHECK(utf16.IsStringInline());
+        CHECK(utf8.StringView() == Heart::HStringView("fifteen chars!!"));
+        CHECK(utf16.StringView() == Heart::HStringView(u"seven!!"));
+        CHECK(utf16.StringView().GetEncoding() == Heart::HString::Encoding::UTF16);
+        CHECK(utf8.String() == Heart::HString("fifteen chars!!"));
+        CHECK(utf8.StringView().DataUTF8()[15] == '\0');
+        CHECK(Heart::Variant(Heart::HString("")).IsStringInline());
+    }
+    SUBCASE("Heap strings")
+    {
+        Heart::HString str = "sixteen chars!!!";
+        Heart::Variant utf8(str);
+        Heart::Variant utf16(Heart::HStringView(u"eight!!!"));
+
+        CHECK_FALSE(utf8.IsStringInline());
+        CHECK_FALSE(utf16.IsStringInline());
+        CHECK(utf8.StringView() == str);
+        CHECK(utf8.StringView().DataRaw() == str.DataRaw()); // shared
+        CHECK(utf16.String() == Heart::HString(u"eight!!!"));
+    }
+    SUBCASE("Copy and assign")
+    {
+        Heart::Variant inlined(Heart::HStringView("short"));
+        Heart::Variant heap(Heart::HStringView("a string too long to be inlined"));
+        Heart::Variant copy = inlined;
+
+        CHECK(copy.IsStringInline());
+        CHECK(copy.StringView() == Heart::HStringView("short"));
+
+        copy = heap;
+        CHECK_FALSE(copy.IsStringInline());
+        CHECK(copy.StringView() == heap.StringView());
+
+        copy = Heart::Variant((s64)3);
+        CHECK(copy.GetType() == Heart::Variant::Type::Int);
+        CHECK_FALSE(copy.IsStringInline());
+
+        copy = inlined;
+        copy = copy;
+        CHECK(copy.StringView() == Heart::HStringView("short"));
+    }
+    SUBCASE("Arrays")
+    {
+        Heart::HArray array;
+        CHECK(array.Data() == nullptr); // nothing allocated until the first add
+
+        array.Add(Heart::HStringView("short"));
+        array.Add(Heart::HStringView("a string too long to be inlined"));
+        array.Add((s64)7);
+
+        Heart::Variant nested(array);
+        Heart::HArray clone = nested.Array().Clone();
+        clone.Add(true);
+
+        CHECK(array.Count() == 3);
+        CHECK(clone.Count() == 4);
+        CHECK(clone[0].StringView() == Heart::HStringView("short"));
+        CHECK(clone[1].StringView() == Heart::HStringView("a string too long to be inlined"));
+        CHECK(clone[2].Int() == 7);
+    }
+    SUBCASE("Json")
+    {
+        Heart::HArray array;
+        array.Add(Heart::HStringView(u"utf16"));
+        array.Add(Heart::HStringView("a string too long to be inlined"));
+        array.Add(2.5);
+
+        nlohmann::json j = array;
+        Heart::HArray parsed = j.get<Heart::HArray>();
+
+        CHECK(j[0] == "utf16");
+        CHECK(parsed.Count() == 3);
+        CHECK(parsed[0].StringView() == Heart::HStringView("utf16"));
+        CHECK(parsed[1].StringView() == Heart::HStringView("a string too long to be inlined"));
+        CHECK(parsed[2].Float() == 2.5);
+    }
+}